@@ -27,7 +27,6 @@ THE SOFTWARE.
 // Platform definitions
 #if defined(_WIN32) || defined(_WIN64)
 #define TBL_WINDOWS
-#define USE_FROM_CHARS
 #pragma warning(push)
 #pragma warning(disable : 4530) // Silence warnings if exceptions are disabled
 #endif
@@ -42,23 +41,71 @@ THE SOFTWARE.
 #endif
 #endif
 
+// Instruction set definitions.  Define TBL_NO_SIMD to force the scalar code paths.
+#ifndef TBL_NO_SIMD
+#if defined(__AVX2__)
+#define TBL_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TBL_SSE2
+#endif
+#endif
+
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <variant>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
-#include <unordered_map>
+#include <list>
+#include <memory>
 #include <algorithm>
-#ifdef USE_FROM_CHARS
-#include <charconv>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <functional>
+#include <exception>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#include <cstdlib>
+#if defined(TBL_AVX2)
+#include <immintrin.h>
+#elif defined(TBL_SSE2)
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef TBL_WINDOWS
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
 #else
-#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #ifdef TBL_WINDOWS
 #pragma warning(pop)
 #endif
 
+// Arenas can be used as std::pmr memory resources if the standard library supports them
+#if defined(__cpp_lib_memory_resource)
+#define TBL_PMR
+#endif
+
 namespace Tbl
 {
 
@@ -67,294 +114,4838 @@ namespace Tbl
 	const size_t DoubleType = 1;
 	const size_t StringType = 2;
 
-	// Table class reads and parses CSV or tab-delimited text
-	template<typename Alloc = std::allocator<char>>
-	class Table
+	namespace Detail
 	{
-	public:
-		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
-		using TableData = std::variant<int64_t, double, String>;
-	private:
-		using TableDataAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<TableData>;
-		using VectorTableData = std::vector<TableData, TableDataAlloc>;
-		using StringIndexPair = std::pair<const String, size_t>;
-		using StringIndexPairAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<StringIndexPair>;
-		using StringIndexMap = std::unordered_map<const String, size_t, std::hash<String>, std::equal_to<String>, StringIndexPairAlloc>;
-	public:
 
-		Table(std::string_view text)
+		inline size_t CountTrailingZeros(uint64_t value)
 		{
-			m_error = !Read(text);
+			assert(value != 0);
+#if defined(_MSC_VER) && defined(_WIN64)
+			unsigned long index = 0;
+			_BitScanForward64(&index, value);
+			return index;
+#elif defined(_MSC_VER)
+			unsigned long index = 0;
+			if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+				return index;
+			_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+			return index + 32;
+#else
+			return static_cast<size_t>(__builtin_ctzll(value));
+#endif
 		}
 
-		explicit operator bool() const { return !m_error; }
-
-		size_t GetNumColumns() const { return m_columnMap.size(); }
-		size_t GetNumRows() const { return m_rowMap.size(); }
-		size_t GetRowIndex(const String & rowName) const
+		inline size_t CountLeadingZeros(uint64_t value)
 		{
-			const auto& pair = m_rowMap.find(rowName);
-			assert(pair != m_rowMap.end());
-			return pair->second;
+			assert(value != 0);
+#if defined(_MSC_VER) && defined(_WIN64)
+			unsigned long index = 0;
+			_BitScanReverse64(&index, value);
+			return 63 - index;
+#elif defined(_MSC_VER)
+			unsigned long index = 0;
+			if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32)))
+				return 31 - index;
+			_BitScanReverse(&index, static_cast<unsigned long>(value));
+			return 63 - index;
+#else
+			return static_cast<size_t>(__builtin_clzll(value));
+#endif
 		}
-		size_t GetColumnIndex(const String & columnName) const
+
+		// Returns the high 64 bits of the full 128-bit product of two numbers, and stores the low
+		// 64 bits in low
+		inline uint64_t MultiplyHigh(uint64_t a, uint64_t b, uint64_t & low)
 		{
-			const auto& pair = m_columnMap.find(columnName);
-			assert(pair != m_columnMap.end());
-			return pair->second;
+#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 UInt128;
+			const UInt128 product = static_cast<UInt128>(a) * b;
+			low = static_cast<uint64_t>(product);
+			return static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			uint64_t high = 0;
+			low = _umul128(a, b, &high);
+			return high;
+#else
+			const uint64_t lowLow = (a & 0xffffffff) * (b & 0xffffffff);
+			const uint64_t lowHigh = (a & 0xffffffff) * (b >> 32);
+			const uint64_t highLow = (a >> 32) * (b & 0xffffffff);
+			const uint64_t highHigh = (a >> 32) * (b >> 32);
+			const uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+			low = (middle << 32) | (lowLow & 0xffffffff);
+			return highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
 		}
-		const TableData& GetData(size_t rowIndex, size_t columnIndex) const
+
+		// Scanner locates structural characters (delimiters, quotes, and line ends) in 64-byte
+		// blocks, using one bit per byte, so parsing can skip directly from one structural
+		// character to the next.  Blocks are built lazily, so a forward walk through the text
+		// visits each block only once.
+		class Scanner
 		{
-			assert(!m_error);
-			assert(rowIndex < GetNumRows());
-			assert(columnIndex < GetNumColumns());
-			size_t index = columnIndex + (rowIndex * GetNumColumns());
-			assert(index < m_tableData.size());
-			return m_tableData[index];
-		}
-		const TableData& GetData(const String & rowName, const String & columnName) const
+		public:
+			static const size_t BlockSize = 64;
+
+			Scanner(std::string_view text, char delimiter) :
+				m_text(text),
+				m_delimiter(delimiter)
+			{
+			}
+
+			std::string_view GetText() const { return m_text; }
+			char GetDelimiter() const { return m_delimiter; }
+
+			// Returns the position of the next double quote at or after pos, or the text size if none is found
+			size_t FindQuote(size_t pos) { return Find(pos, &Scanner::m_quoteMask); }
+
+			// Returns the position of the next delimiter or line end at or after pos, or the text size if none is found
+			size_t FindCellEnd(size_t pos) { return Find(pos, &Scanner::m_cellEndMask); }
+
+			// Returns the position of the next line end at or after pos, or the text size if none is found
+			size_t FindLineEnd(size_t pos) { return Find(pos, &Scanner::m_lineEndMask); }
+
+			// Returns the number of double quotes in the range [begin, end)
+			size_t CountQuotes(size_t begin, size_t end)
+			{
+				size_t count = 0;
+				for (size_t pos = FindQuote(begin); pos < end; pos = FindQuote(pos + 1))
+					++count;
+				return count;
+			}
+
+			// Estimates the number of rows in the range [begin, end), which must begin outside of
+			// quotes, by counting line feeds outside of quotes, or carriage returns if there are no
+			// line feeds.  Whether each byte is inside quotes is found for a whole block at once with
+			// a prefix XOR of its quote bits.  Quotes inside unquoted cells or blank lines can make
+			// the count inexact, so it's only suitable for reserving space.
+			size_t EstimateRows(size_t begin, size_t end) const
+			{
+				size_t lineFeeds = 0;
+				size_t carriageReturns = 0;
+				uint64_t inside = 0;
+				for (size_t offset = begin - begin % BlockSize; offset < end; offset += BlockSize)
+				{
+					char padded[BlockSize];
+					const char * data = GetBlock(offset, padded);
+					uint64_t range = ~uint64_t(0);
+					if (offset < begin)
+						range <<= begin - offset;
+					if (end - offset < BlockSize)
+						range &= (uint64_t(1) << (end - offset)) - 1;
+					uint64_t quoted = MatchBlock(data, '"') & range;
+					quoted ^= quoted << 1;
+					quoted ^= quoted << 2;
+					quoted ^= quoted << 4;
+					quoted ^= quoted << 8;
+					quoted ^= quoted << 16;
+					quoted ^= quoted << 32;
+					quoted ^= inside;
+					inside = (quoted >> 63) ? ~uint64_t(0) : 0;
+					lineFeeds += PopCount(MatchBlock(data, '\n') & range & ~quoted);
+					carriageReturns += PopCount(MatchBlock(data, '\r') & range & ~quoted);
+				}
+				return lineFeeds ? lineFeeds + 1 : carriageReturns + 1;
+			}
+
+		private:
+
+			static size_t PopCount(uint64_t value)
+			{
+#if defined(_MSC_VER) && defined(_WIN64)
+				return static_cast<size_t>(__popcnt64(value));
+#elif defined(_MSC_VER)
+				return static_cast<size_t>(__popcnt(static_cast<uint32_t>(value)) + __popcnt(static_cast<uint32_t>(value >> 32)));
+#else
+				return static_cast<size_t>(__builtin_popcountll(value));
+#endif
+			}
+
+			// Returns the block of text at offset, copying a partial final block into a zero-padded
+			// buffer so a full block can always be read.
+			const char * GetBlock(size_t offset, char (&padded)[BlockSize]) const
+			{
+				const char * data = m_text.data() + offset;
+				if (m_text.size() - offset >= BlockSize)
+					return data;
+				std::fill(std::begin(padded), std::end(padded), '\0');
+				std::copy(data, m_text.data() + m_text.size(), padded);
+				return padded;
+			}
+
+			size_t Find(size_t pos, uint64_t Scanner::* mask)
+			{
+				while (pos < m_text.size())
+				{
+					const size_t block = pos / BlockSize;
+					if (block != m_block)
+						LoadBlock(block);
+					const uint64_t bits = (this->*mask) >> (pos % BlockSize);
+					if (bits)
+						return pos + CountTrailingZeros(bits);
+					pos = (block + 1) * BlockSize;
+				}
+				return m_text.size();
+			}
+
+			void LoadBlock(size_t block)
+			{
+				char padded[BlockSize];
+				const char * data = GetBlock(block * BlockSize, padded);
+
+				m_quoteMask = MatchBlock(data, '"');
+				m_lineEndMask = MatchBlock(data, '\n') | MatchBlock(data, '\r');
+				m_cellEndMask = MatchBlock(data, m_delimiter) | m_lineEndMask;
+				m_block = block;
+			}
+
+			static uint64_t MatchBlock(const char * data, char c)
+			{
+#if defined(TBL_AVX2)
+				const __m256i match = _mm256_set1_epi8(c);
+				const uint64_t lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)), match)));
+				const uint64_t hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + 32)), match)));
+				return lo | (hi << 32);
+#elif defined(TBL_SSE2)
+				const __m128i match = _mm_set1_epi8(c);
+				uint64_t mask = 0;
+				for (size_t i = 0; i < BlockSize; i += 16)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+					const uint64_t bits = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, match)));
+					mask |= bits << i;
+				}
+				return mask;
+#else
+				uint64_t mask = 0;
+				for (size_t i = 0; i < BlockSize; ++i)
+				{
+					if (data[i] == c)
+						mask |= uint64_t(1) << i;
+				}
+				return mask;
+#endif
+			}
+
+			std::string_view m_text;
+			char m_delimiter;
+			size_t m_block = SIZE_MAX;
+			uint64_t m_quoteMask = 0;
+			uint64_t m_lineEndMask = 0;
+			uint64_t m_cellEndMask = 0;
+		};
+
+		// MappedFile maps an entire file into memory as read-only text
+		class MappedFile
 		{
-			return GetData(GetRowIndex(rowName), GetColumnIndex(columnName));
+		public:
+			explicit MappedFile(std::string_view path)
+			{
+				const std::string filename(path);
+#ifdef TBL_WINDOWS
+				m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+				if (m_file == INVALID_HANDLE_VALUE)
+					return;
+				LARGE_INTEGER size = {};
+				if (!GetFileSizeEx(m_file, &size))
+					return;
+				m_valid = true;
+				if (size.QuadPart == 0)
+					return;
+				m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (!m_mapping)
+				{
+					m_valid = false;
+					return;
+				}
+				const void * data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+				if (!data)
+				{
+					m_valid = false;
+					return;
+				}
+				m_text = std::string_view(static_cast<const char *>(data), static_cast<size_t>(size.QuadPart));
+#else
+				const int file = open(filename.c_str(), O_RDONLY);
+				if (file < 0)
+					return;
+				struct stat info = {};
+				if (fstat(file, &info) == 0)
+				{
+					m_valid = true;
+					if (info.st_size > 0)
+					{
+						void * data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+						if (data != MAP_FAILED)
+						{
+							madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+							m_text = std::string_view(static_cast<const char *>(data), static_cast<size_t>(info.st_size));
+						}
+						else
+							m_valid = false;
+					}
+				}
+				close(file);
+#endif
+			}
+
+			~MappedFile()
+			{
+#ifdef TBL_WINDOWS
+				if (!m_text.empty())
+					UnmapViewOfFile(m_text.data());
+				if (m_mapping)
+					CloseHandle(m_mapping);
+				if (m_file != INVALID_HANDLE_VALUE)
+					CloseHandle(m_file);
+#else
+				if (!m_text.empty())
+					munmap(const_cast<char *>(m_text.data()), m_text.size());
+#endif
+			}
+
+			MappedFile(const MappedFile &) = delete;
+			MappedFile & operator = (const MappedFile &) = delete;
+
+			explicit operator bool() const { return m_valid; }
+			std::string_view GetText() const { return m_text; }
+
+		private:
+			std::string_view m_text;
+			bool m_valid = false;
+#ifdef TBL_WINDOWS
+			HANDLE m_file = INVALID_HANDLE_VALUE;
+			HANDLE m_mapping = nullptr;
+#endif
+		};
+
+		// Finalizes a hash value so that all bits depend on all input bits
+		constexpr uint64_t MixHash(uint64_t hash)
+		{
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			hash *= 0xc4ceb9fe1a85ec53ull;
+			hash ^= hash >> 33;
+			return hash;
 		}
-		template <typename T>
-		const T & Get(size_t rowIndex, size_t columnIndex) const
+
+		// FNV-1a string hash, finalized with MixHash.  A non-zero seed selects a different hash function.
+		constexpr uint64_t HashString(std::string_view str, uint64_t seed = 0)
 		{
-			return std::get<T>(GetData(rowIndex, columnIndex));
+			uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+			for (char c : str)
+				hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+			return MixHash(hash);
 		}
-		template <typename T>
-		const T & Get(const String & rowName, const String & columnName) const
+
+		// Maps the low 32 bits of a hash onto the range [0, range) without a division
+		inline size_t ReduceHash(uint64_t hash, size_t range)
 		{
-			return std::get<T>(GetData(GetRowIndex(rowName), GetColumnIndex(columnName)));
+			return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(hash)) * range) >> 32);
 		}
 
-	private:
+		inline bool IsSpace(char c)
+		{
+			return c == ' ' || (c >= '\t' && c <= '\r');
+		}
 
-		enum class Format
+		// Types of number recognized by ParseNumber
+		enum class NumberType
 		{
-			International,
-			Continental
+			None,
+			Integer,
+			Double
 		};
 
-		bool IsLineEnd(std::string_view::const_iterator current) const
+		// Bits of a double with an infinite exponent, used to detect overflow
+		const uint64_t InfinityBits = uint64_t(0x7ff) << 52;
+
+		// 128-bit powers of five from 5^-342 to 5^308, as high and low halves, normalized so the
+		// highest bit is set.  Negative powers are rounded up, and the rest are truncated.
+		inline constexpr uint64_t PowersOfFive[] =
 		{
-			return *current == '\n' || *current == '\r';
-		}
+			0xeef453d6923bd65aull, 0x113faa2906a13b3full, 0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+			0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull, 0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+			0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull, 0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+			0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull, 0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+			0xb208ef855c969f4full, 0xbdbd2d335e51a935ull, 0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+			0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull, 0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+			0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull, 0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+			0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull, 0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+			0x84a57695fe98746dull, 0x014bb630f7604b57ull, 0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+			0xcf42894a5dce35eaull, 0x52064cac828675b9ull, 0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+			0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull, 0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+			0xfd00b897478238d0ull, 0x8920b098955522b4ull, 0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+			0xc5a890362fddbc62ull, 0xeb2189f734aa831dull, 0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+			0x9a6bb0aa55653b2dull, 0x47b233c92125366eull, 0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+			0xf148440a256e2c76ull, 0xc00670ea43ca250dull, 0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+			0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull, 0xeba09271e88d976bull, 0xf7864a44c633682eull,
+			0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull, 0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+			0xe61acf033d1a45dfull, 0x6fb92487298e33bdull, 0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+			0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull, 0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+			0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull, 0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+			0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull, 0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+			0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull, 0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+			0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull, 0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+			0xd1476e2c07286faaull, 0x1af5af660db4aee1ull, 0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+			0xa37fce126597973cull, 0xe50ff107bab528a0ull, 0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+			0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull, 0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+			0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull, 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+			0x9becce62836ac577ull, 0x4ee367f9430aec32ull, 0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+			0xf3a20279ed56d48aull, 0x6b43527578c1110full, 0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+			0xbe5691ef416bd60cull, 0x23cc986bc656d553ull, 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+			0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull, 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+			0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull, 0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+			0xb58547448ffffb2dull, 0xabd40a0c2832a78aull, 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+			0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull, 0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+			0xdd95317f31c7fa1dull, 0x40405643d711d583ull, 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+			0xad1c8eab5ee43b66ull, 0xda3243650005eecfull, 0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+			0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull, 0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+			0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull, 0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+			0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull, 0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+			0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull, 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+			0xc987434744ac874eull, 0xa327ffb266b56220ull, 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+			0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull, 0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+			0xf6019da07f549b2bull, 0x7e2a53a146606a48ull, 0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+			0xc0314325637a1939ull, 0xfa911155fefb5308ull, 0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+			0x96267c7535b763b5ull, 0x4bc1558b2f3458deull, 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+			0xea9c227723ee8bcbull, 0x465e15a979c1cadcull, 0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+			0xb749faed14125d36ull, 0xcef980ec671f667bull, 0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+			0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull, 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+			0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull, 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+			0xaecc49914078536dull, 0x58fae9f773886e18ull, 0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+			0x888f99797a5e012dull, 0x6d8406c952429603ull, 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+			0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull, 0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+			0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull, 0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+			0x823c12795db6ce57ull, 0x76c53d08d6b70858ull, 0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+			0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull, 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+			0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull, 0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+			0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull, 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+			0xc21094364dfb5636ull, 0x985915fc12f542e4ull, 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+			0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull, 0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+			0xece53cec4a314ebdull, 0xa4f8bf5635246428ull, 0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+			0xb913179899f68584ull, 0x28e2557b59846e3full, 0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+			0x9096ea6f3848984full, 0x3ff0d2c85def7621ull, 0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+			0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull, 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+			0xb080392cc4349decull, 0xbd8d794d96aacfb3ull, 0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+			0x89e42caaf9491b60ull, 0xf41686c49db57244ull, 0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+			0xd77485cb25823ac7ull, 0x7d633293366b828bull, 0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+			0xa8530886b54dbdebull, 0xd9f57f830283fdfcull, 0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+			0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull, 0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+			0xcd795be870516656ull, 0x67902e276c921f8bull, 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+			0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull, 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+			0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull, 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+			0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull, 0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+			0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull, 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+			0xef340a98172aace4ull, 0x86fb897116c87c34ull, 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+			0xbae0a846d2195712ull, 0x8974836059cca109ull, 0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+			0x91ff83775423cc06ull, 0x7b6306a34627ddcfull, 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+			0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull, 0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+			0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull, 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+			0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull, 0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+			0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull, 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+			0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull, 0xd47487cc8470652bull, 0x7647c3200069671full,
+			0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull, 0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+			0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull, 0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+			0xa21727db38cb002full, 0xb8ada00e5a506a7cull, 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+			0xfd442e4688bd304aull, 0x908f4a166d1da663ull, 0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+			0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull, 0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+			0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull, 0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+			0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull, 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+			0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull, 0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+			0x936b9fcebb25c995ull, 0xcab10dd900beec34ull, 0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+			0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull, 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+			0xb3f4e093db73a093ull, 0x59ed216765690f56ull, 0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+			0x8c974f7383725573ull, 0x1e414218c73a13fbull, 0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+			0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull, 0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+			0xab9eb47c81f5114full, 0x066ea92f3f326564ull, 0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+			0x8613fd0145877585ull, 0xbd06742ce95f5f36ull, 0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+			0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull, 0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+			0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull, 0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+			0xffbbcfe994e5c61full, 0xfdf17746497f7052ull, 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+			0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull, 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+			0x9c1661a651213e2dull, 0x06bea10ca65c084eull, 0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+			0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull, 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+			0xbe89523386091465ull, 0xf6bbb397f1135823ull, 0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+			0x94db483840b717efull, 0xa8c2a44eb4571cdcull, 0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+			0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull, 0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+			0xb5b5ada8aaff80b8ull, 0x0d819992132456baull, 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+			0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull, 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+			0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull, 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+			0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull, 0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+			0x87625f056c7c4a8bull, 0x11471cd764ad4972ull, 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+			0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull, 0x843610cb4bf160cbull, 0xcedf722a585139baull,
+			0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull, 0xce947a3da6a9273eull, 0x733d226229feea32ull,
+			0x811ccc668829b887ull, 0x0806357d5a3f525full, 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+			0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull, 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+			0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull, 0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+			0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull, 0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+			0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull, 0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+			0x964e858c91ba2655ull, 0x3a6a07f8d510f86full, 0xbbe226efb628afeaull, 0x890489f70a55368bull,
+			0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull, 0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+			0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull, 0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+			0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull, 0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+			0xdff9772470297ebdull, 0x59787e2b93bc56f7ull, 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+			0xaefae51477a06b03ull, 0xede622920b6b23f1ull, 0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+			0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull, 0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+			0xd59944a37c0752a2ull, 0x4be76d3346f0495full, 0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+			0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull, 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+			0x825ecc24c873782full, 0x8ed400668c0c28c8ull, 0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+			0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull, 0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+			0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull, 0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+			0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull, 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+			0xc24452da229b021bull, 0xfbe85badce996168ull, 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+			0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull, 0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+			0xed246723473e3813ull, 0x290123e9aab23b68ull, 0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+			0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull, 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+			0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull, 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+			0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull, 0x8d590723948a535full, 0x579c487e5a38ad0eull,
+			0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull, 0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+			0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull, 0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+			0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full, 0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+			0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull, 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+			0x83a3eeeef9153e89ull, 0x1953cf68300424acull, 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+			0xcdb02555653131b6ull, 0x3792f412cb06794dull, 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+			0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull, 0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+			0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull, 0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+			0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull, 0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+			0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull, 0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+			0xef73d256a5c0f77cull, 0x963e66858f6d4440ull, 0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+			0xbb127c53b17ec159ull, 0x5560c018580d5d52ull, 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+			0x9226712162ab070dull, 0xcab3961304ca70e8ull, 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+			0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull, 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+			0xb267ed1940f1c61cull, 0x55f038b237591ed3ull, 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+			0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull, 0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+			0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull, 0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+			0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull, 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+			0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull, 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+			0xcfb11ead453994baull, 0x67de18eda5814af2ull, 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+			0xa2425ff75e14fc31ull, 0xa1258379a94d028dull, 0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+			0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull, 0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+			0xc612062576589ddaull, 0x95364afe032a819eull, 0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+			0x9abe14cd44753b52ull, 0xc4926a9672793543ull, 0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+			0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull, 0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+			0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull, 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+			0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull, 0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+			0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull, 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+			0xb424dc35095cd80full, 0x538484c19ef38c95ull, 0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+			0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull, 0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+			0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull, 0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+			0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull, 0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+			0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull, 0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+			0xd1b71758e219652bull, 0xd3c36113404ea4a9ull, 0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+			0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull, 0xccccccccccccccccull, 0xcccccccccccccccdull,
+			0x8000000000000000ull, 0x0000000000000000ull, 0xa000000000000000ull, 0x0000000000000000ull,
+			0xc800000000000000ull, 0x0000000000000000ull, 0xfa00000000000000ull, 0x0000000000000000ull,
+			0x9c40000000000000ull, 0x0000000000000000ull, 0xc350000000000000ull, 0x0000000000000000ull,
+			0xf424000000000000ull, 0x0000000000000000ull, 0x9896800000000000ull, 0x0000000000000000ull,
+			0xbebc200000000000ull, 0x0000000000000000ull, 0xee6b280000000000ull, 0x0000000000000000ull,
+			0x9502f90000000000ull, 0x0000000000000000ull, 0xba43b74000000000ull, 0x0000000000000000ull,
+			0xe8d4a51000000000ull, 0x0000000000000000ull, 0x9184e72a00000000ull, 0x0000000000000000ull,
+			0xb5e620f480000000ull, 0x0000000000000000ull, 0xe35fa931a0000000ull, 0x0000000000000000ull,
+			0x8e1bc9bf04000000ull, 0x0000000000000000ull, 0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+			0xde0b6b3a76400000ull, 0x0000000000000000ull, 0x8ac7230489e80000ull, 0x0000000000000000ull,
+			0xad78ebc5ac620000ull, 0x0000000000000000ull, 0xd8d726b7177a8000ull, 0x0000000000000000ull,
+			0x878678326eac9000ull, 0x0000000000000000ull, 0xa968163f0a57b400ull, 0x0000000000000000ull,
+			0xd3c21bcecceda100ull, 0x0000000000000000ull, 0x84595161401484a0ull, 0x0000000000000000ull,
+			0xa56fa5b99019a5c8ull, 0x0000000000000000ull, 0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+			0x813f3978f8940984ull, 0x4000000000000000ull, 0xa18f07d736b90be5ull, 0x5000000000000000ull,
+			0xc9f2c9cd04674edeull, 0xa400000000000000ull, 0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+			0x9dc5ada82b70b59dull, 0xf020000000000000ull, 0xc5371912364ce305ull, 0x6c28000000000000ull,
+			0xf684df56c3e01bc6ull, 0xc732000000000000ull, 0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+			0xc097ce7bc90715b3ull, 0x4b9f100000000000ull, 0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+			0x96769950b50d88f4ull, 0x1314448000000000ull, 0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+			0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull, 0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+			0xb7abc627050305adull, 0xf14a3d9e40000000ull, 0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+			0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull, 0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+			0xe0352f62a19e306eull, 0xd50b2037ad200000ull, 0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+			0xaf298d050e4395d6ull, 0x9670b12b7f410000ull, 0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+			0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull, 0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+			0xd5d238a4abe98068ull, 0x72a4904598d6d880ull, 0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+			0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull, 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+			0x82818f1281ed449full, 0xbff8f10e7a8921a4ull, 0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+			0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull, 0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+			0x9f4f2726179a2245ull, 0x01d762422c946590ull, 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+			0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull, 0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+			0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull, 0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+			0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull, 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+			0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull, 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+			0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull, 0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+			0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull, 0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+			0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull, 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+			0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull, 0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+			0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull, 0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+			0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull, 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+			0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull, 0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+			0x83c7088e1aab65dbull, 0x792667c6da79e0faull, 0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+			0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull, 0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+			0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull, 0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+			0xfb5878494ace3a5full, 0x04ab48a04065c723ull, 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+			0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull, 0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+			0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull, 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+			0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull, 0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+			0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull, 0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+			0x924d692ca61be758ull, 0x593c2626705f9c56ull, 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+			0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull, 0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+			0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull, 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+			0x8b865b215899f46cull, 0xbd79e0d20082ee74ull, 0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+			0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull, 0x884134fe908658b2ull, 0x3109058d147fdcddull,
+			0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull, 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+			0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull, 0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+			0xcfe87f7cef46ff16ull, 0xe612641865679a63ull, 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+			0xa26da3999aef7749ull, 0xe3be5e330f38f09dull, 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+			0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull, 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+			0xc646d63501a1511dull, 0xb281e1fd541501b8ull, 0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+			0x9ae757596946075full, 0x3375788de9b06958ull, 0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+			0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull, 0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+			0xbd176620a501fbffull, 0xb650e5a93bc3d898ull, 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+			0x93ba47c980e98cdfull, 0xc66f336c36b10137ull, 0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+			0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull, 0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+			0xb454e4a179dd1877ull, 0x29babe4598c311fbull, 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+			0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull, 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+			0xdc21a1171d42645dull, 0x76707543f4fa1f73ull, 0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+			0xabfa45da0edbde69ull, 0x0487db9d17636892ull, 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+			0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull, 0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+			0xd1ef0244af2364ffull, 0x3207d795430cd926ull, 0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+			0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull, 0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+			0x802221226be55a64ull, 0xc2494954da2c9789ull, 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+			0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull, 0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+			0x9c69a97284b578d7ull, 0xff2a760414536efbull, 0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+			0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull, 0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+			0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull, 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+			0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull, 0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+			0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull, 0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+			0xb616a12b7fe617aaull, 0x577b986b314d6009ull, 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+			0x8e41ade9fbebc27dull, 0x14588f13be847307ull, 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+			0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull, 0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+			0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull, 0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+			0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull, 0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+			0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull, 0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+			0xa59bc234db398c25ull, 0x43fab9837e699095ull, 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+			0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull, 0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+			0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull, 0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+			0x9defbf01b061adabull, 0x3a0888136afa64a7ull, 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+			0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull, 0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+			0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull, 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+			0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull, 0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+			0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull, 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+			0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full, 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+			0x8fa475791a569d10ull, 0xf96e017d694487bcull, 0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+			0xe070f78d3927556aull, 0x85bbe253f47b1417ull, 0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+			0xaf58416654a6babbull, 0x387ac8d1970027b2ull, 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+			0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull, 0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+			0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull, 0x85c7056562757456ull, 0xf6872d5667844e49ull,
+			0xa738c6bebb12d16cull, 0xb428f8ac016561dbull, 0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+			0x82a45b450226b39cull, 0xecc0024661173473ull, 0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+			0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull, 0xff290242c83396ceull, 0x7e67047175a15271ull,
+			0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull, 0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+			0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull, 0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+			0xc2abf989935ddbfeull, 0x6acff893d00ea435ull, 0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+			0x98165af37b2153deull, 0xc3727a337a8b704aull, 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+			0xeda2ee1c7064130cull, 0x1162def06f79df73ull, 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+			0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull, 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+			0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull, 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+			0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull, 0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+			0xb10d8e1456105dadull, 0x7425a83e872c5f47ull, 0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+			0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full, 0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+			0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull, 0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+			0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull, 0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+			0x83ea2b892091e44dull, 0x934aed0aab460432ull, 0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+			0xce1de40642e3f4b9ull, 0x36251260ab9d668eull, 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+			0xa1075a24e4421730ull, 0xb24cf65b8612f81full, 0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+			0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull, 0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+			0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull, 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+			0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull, 0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+			0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull, 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+			0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull, 0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+			0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull, 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+			0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull, 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+			0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull, 0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+			0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull, 0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+			0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull, 0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+			0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull, 0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+			0x8533285c936b35deull, 0xd53a88958f87275full, 0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+			0xd01fef10a657842cull, 0x2d2b7569b0432d85ull, 0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+			0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full, 0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+			0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull, 0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+			0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull, 0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+			0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull, 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+			0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull, 0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+			0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull, 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+			0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull, 0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+			0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull, 0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+			0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull, 0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+			0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull, 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+			0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull, 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+			0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull, 0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+			0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull, 0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+			0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull, 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+			0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull, 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+			0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull, 0xa0555e361951c366ull, 0xd7e105bcc332621full,
+			0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull, 0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+			0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull, 0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+			0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull, 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+			0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull, 0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+			0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull, 0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+			0xe950df20247c83fdull, 0x47c6b82ef32a2069ull, 0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+			0xb6472e511c81471dull, 0xe0133fe4adf8e952ull, 0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+			0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+		};
 
-		void AdvanceToNextLine(std::string_view text, std::string_view::const_iterator & current) const
+		// Computes the bits of the positive double nearest to mantissa * 10^exponent using the
+		// Eisel-Lemire algorithm, where mantissa is non-zero.  The mantissa is multiplied by a
+		// truncated 128-bit power of five, which is always precise enough to round correctly.
+		// Returns zero on underflow and InfinityBits on overflow.
+		inline uint64_t ComputeDouble(uint64_t mantissa, int64_t exponent)
 		{
-			while (current != text.end())
+			const int MantissaBits = 52;
+			const int64_t SmallestPower = -342;
+			const int64_t LargestPower = 308;
+			assert(mantissa != 0);
+			if (exponent < SmallestPower)
+				return 0;
+			if (exponent > LargestPower)
+				return InfinityBits;
+			const int zeros = static_cast<int>(CountLeadingZeros(mantissa));
+			mantissa <<= zeros;
+
+			// The low half of the power only matters if the bits below those needed are all ones
+			const size_t index = static_cast<size_t>(exponent - SmallestPower) * 2;
+			uint64_t low = 0;
+			uint64_t high = MultiplyHigh(mantissa, PowersOfFive[index], low);
+			const uint64_t precisionMask = UINT64_MAX >> (MantissaBits + 3);
+			if ((high & precisionMask) == precisionMask)
 			{
-				if (!IsLineEnd(current))
-					break;
-				++current;
+				uint64_t secondLow = 0;
+				const uint64_t secondHigh = MultiplyHigh(mantissa, PowersOfFive[index + 1], secondLow);
+				low += secondHigh;
+				if (secondHigh > low)
+					++high;
+			}
+
+			// Keep one more bit than needed for rounding, and approximate log2(10^exponent)
+			const int upperBit = static_cast<int>(high >> 63);
+			const int shift = upperBit + 64 - MantissaBits - 3;
+			uint64_t bits = high >> shift;
+			int64_t power2 = (((152170 + 65536) * exponent) >> 16) + 63 + upperBit - zeros + 1023;
+			if (power2 <= 0)
+			{
+				// Subnormal numbers shift out the bits below the smallest exponent.  Rounding up may
+				// carry into the exponent, producing the smallest normal number.
+				if (-power2 + 1 >= 64)
+					return 0;
+				bits >>= -power2 + 1;
+				bits += bits & 1;
+				return bits >> 1;
+			}
+
+			// Products with small powers of ten are exact, so a value that's exactly halfway between
+			// two doubles is rounded to even instead of up
+			if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 && (bits << shift) == high)
+				bits &= ~uint64_t(1);
+			bits += bits & 1;
+			bits >>= 1;
+			if (bits >= (uint64_t(2) << MantissaBits))
+			{
+				bits = uint64_t(1) << MantissaBits;
+				++power2;
 			}
+			if (power2 >= 0x7ff)
+				return InfinityBits;
+			return (bits & ~(uint64_t(1) << MantissaBits)) | (static_cast<uint64_t>(power2) << MantissaBits);
 		}
 
-		bool DetectDelimiter(std::string_view text, char & delimiter, Format & format) const
+		// Decimal holds the digits of a number exactly, so numbers too close to halfway between two
+		// doubles for the Eisel-Lemire algorithm to decide can still be rounded correctly.  It's
+		// scaled by powers of two until it holds the double's mantissa.  Digits past the first 800
+		// can only break a tie, so they're just recorded as truncated.  Every double's exact value
+		// fits, so it's also used to format doubles.
+		class Decimal
 		{
-			size_t tabCount = 0;
-			size_t commaCount = 0;
-			size_t semicolonCount = 0;
-			auto current = text.begin();
-			while (current != text.end())
+		public:
+			// Holds the exact value of mantissa * 2^power2
+			Decimal(uint64_t mantissa, int power2)
 			{
-				const char c = *current;
-				if (c == ',')
-					++commaCount;
-				else if (c == '\t')
-					++tabCount;
-				else if (c == ';')
-					++semicolonCount;
-				else if (IsLineEnd(current))
-					break;
-				++current;
+				uint8_t digits[20];
+				for (; mantissa > 0; mantissa /= 10)
+					digits[m_count++] = static_cast<uint8_t>(mantissa % 10);
+				for (int digit = 0; digit < m_count; ++digit)
+					m_digits[digit] = digits[m_count - digit - 1];
+				m_point = m_count;
+				Trim();
+				Shift(power2);
 			}
-			if (tabCount == 0 && commaCount == 0 && semicolonCount == 0)
-				return false;
-			delimiter = (commaCount >= tabCount) ? ((commaCount > semicolonCount) ? ',' : ';') : '\t';
-			format = delimiter == ';' ? Format::Continental : Format::International;
-			return true;
-		}
 
-        bool ParseInteger(const String & str, int64_t& intValue) const
-        {
-#ifdef USE_FROM_CHARS
-            auto result = std::from_chars(str.data(), str.data() + str.size(), intValue);
-            if (result.ptr == str.data() + str.size())
-                return true;
-            return false;
-#else
-            char * endPtr;
-            intValue = strtoll(str.data(), &endPtr, 10);
-            if (endPtr != (str.data() + str.size()))
-                return false;
-            return true;
-#endif
-        }
-
-        bool ParseDouble(const String & str, double & doubleValue, Format format) const
-        {
-#ifdef USE_FROM_CHARS
-			// In case contintental format is used, replace commas with decimal point
-			if (format == Format::Continental)
-			{
-				String s = str;
-				std::replace(s.begin(), s.end(), ',', '.');
-				auto result = std::from_chars(s.data(), s.data() + s.size(), doubleValue);
-				if (result.ptr == s.data() + s.size())
-					return true;
+			// Reads the digits of a number that has already been validated, ignoring its sign
+			Decimal(const char * current, const char * end, char decimalPoint)
+			{
+				if (current != end && (*current == '-' || *current == '+'))
+					++current;
+				bool point = false;
+				for (; current != end && *current != 'e' && *current != 'E'; ++current)
+				{
+					if (*current == '.' || *current == decimalPoint)
+					{
+						point = true;
+						m_point = m_count;
+					}
+					else if (*current == '0' && m_count == 0)
+						--m_point;
+					else if (m_count < MaxDigits)
+						m_digits[m_count++] = static_cast<uint8_t>(*current - '0');
+					else if (*current != '0')
+						m_truncated = true;
+				}
+				if (!point)
+					m_point = m_count;
+				if (current != end)
+				{
+					++current;
+					bool negativeExponent = false;
+					if (*current == '-' || *current == '+')
+						negativeExponent = *current++ == '-';
+					int64_t exponent = 0;
+					for (; current != end; ++current)
+					{
+						if (exponent < 100000)
+							exponent = exponent * 10 + (*current - '0');
+					}
+					m_point += negativeExponent ? -exponent : exponent;
+				}
+				Trim();
 			}
-			else
+
+			// Returns the bits of the nearest positive double, zero on underflow, or InfinityBits on
+			// overflow
+			uint64_t ToDouble()
 			{
-				auto result = std::from_chars(str.data(), str.data() + str.size(), doubleValue);
-				if (result.ptr == str.data() + str.size())
-					return true;
+				const int MantissaBits = 52;
+				const int64_t Bias = -1023;
+				if (m_count == 0 || m_point < -330)
+					return 0;
+				if (m_point > 310)
+					return InfinityBits;
+
+				// Scale into [0.5, 1) by powers of two, using the largest shifts that can't overshoot
+				static const int Shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+				const int64_t ShiftCount = sizeof(Shifts) / sizeof(Shifts[0]);
+				int64_t power2 = 0;
+				while (m_point > 0)
+				{
+					const int shift = m_point >= ShiftCount ? 27 : Shifts[m_point];
+					Shift(-shift);
+					power2 += shift;
+				}
+				while (m_point < 0 || (m_point == 0 && m_digits[0] < 5))
+				{
+					const int shift = -m_point >= ShiftCount ? 27 : Shifts[-m_point];
+					Shift(shift);
+					power2 -= shift;
+				}
+
+				// Doubles are in [1, 2) rather than [0.5, 1).  Subnormals are shifted down to the
+				// smallest exponent.
+				--power2;
+				if (power2 < Bias + 1)
+				{
+					Shift(-static_cast<int>(Bias + 1 - power2));
+					power2 = Bias + 1;
+				}
+				if (power2 - Bias >= 0x7ff)
+					return InfinityBits;
+				Shift(MantissaBits + 1);
+				uint64_t mantissa = RoundedInteger();
+				if (mantissa == uint64_t(2) << MantissaBits)
+				{
+					mantissa >>= 1;
+					if (++power2 - Bias >= 0x7ff)
+						return InfinityBits;
+				}
+				if ((mantissa & (uint64_t(1) << MantissaBits)) == 0)
+					power2 = Bias;
+				return (mantissa & ((uint64_t(1) << MantissaBits) - 1)) | (static_cast<uint64_t>(power2 - Bias) << MantissaBits);
 			}
-            return false;
-#else
-			if (format == Format::Continental)
-			{
-				String s = str;
-				std::replace(s.begin(), s.end(), ',', '.');
-				std::istringstream istr(s.c_str());
-				istr.imbue(std::locale::classic());
-				istr >> doubleValue;
-				if (istr.fail())
-					return false;
+
+			// Returns the digits rounded to at most count digits, with ties to even, and sets point
+			// to the position of the decimal point before the first digit
+			std::string Round(int count, int64_t & point) const
+			{
+				std::string digits;
+				for (int digit = 0; digit < count && digit < m_count; ++digit)
+					digits += static_cast<char>('0' + m_digits[digit]);
+				point = m_point;
+				if (ShouldRoundUp(count))
+				{
+					while (!digits.empty() && digits.back() == '9')
+						digits.pop_back();
+					if (digits.empty())
+					{
+						digits = "1";
+						++point;
+					}
+					else
+						++digits.back();
+				}
+				while (!digits.empty() && digits.back() == '0')
+					digits.pop_back();
+				return digits;
 			}
-			else
+
+		private:
+			static constexpr int MaxDigits = 800;
+			static constexpr int MaxShift = 60;
+
+			void Trim()
 			{
-				std::istringstream istr(str.c_str());
-				istr.imbue(std::locale::classic());
-				istr >> doubleValue;
-				if (istr.fail())
-					return false;
+				while (m_count > 0 && m_digits[m_count - 1] == 0)
+					--m_count;
+				if (m_count == 0)
+					m_point = 0;
 			}
-            return true;
-#endif
-        }
 
-		TableData ParseData(const String & str, Format format) const
-		{
-			int64_t intValue = 0;
-			if (ParseInteger(str, intValue))
-				return intValue;
-			else
+			// Multiplies by 2^shift if positive, or divides by 2^-shift if negative
+			void Shift(int shift)
 			{
-				double doubleValue = 0.0;
-				if (ParseDouble(str, doubleValue, format))
-					return doubleValue;
+				if (m_count == 0)
+					return;
+				for (; shift > MaxShift; shift -= MaxShift)
+					ShiftLeft(MaxShift);
+				for (; shift < -MaxShift; shift += MaxShift)
+					ShiftRight(MaxShift);
+				if (shift > 0)
+					ShiftLeft(shift);
+				else if (shift < 0)
+					ShiftRight(-shift);
 			}
-			return str;
-		}
 
-		String ParseCell(std::string_view text, char delimiter, std::string_view::const_iterator & current) const
-		{
-			// Check if this cell is double-quoted
-			bool quoted = *current == '"';
-			if (quoted)
-				++current;
+			void ShiftLeft(int shift)
+			{
+				// Digits are multiplied from last to first, and written from the end of a buffer
+				// with room for the digits the carry adds
+				uint8_t shifted[MaxDigits + 20];
+				int write = MaxDigits + 20;
+				uint64_t carry = 0;
+				for (int read = m_count - 1; read >= 0; --read)
+				{
+					carry += uint64_t(m_digits[read]) << shift;
+					shifted[--write] = static_cast<uint8_t>(carry % 10);
+					carry /= 10;
+				}
+				for (; carry > 0; carry /= 10)
+					shifted[--write] = static_cast<uint8_t>(carry % 10);
+				const int count = MaxDigits + 20 - write;
+				m_point += count - m_count;
+				m_count = std::min(count, MaxDigits);
+				for (int digit = m_count; digit < count; ++digit)
+					m_truncated |= shifted[write + digit] != 0;
+				std::memcpy(m_digits, shifted + write, static_cast<size_t>(m_count));
+				Trim();
+			}
 
-			String str;
-			while (current != text.end())
+			void ShiftRight(int shift)
 			{
-				const char c = *current;
-				if (quoted)
+				// Read enough leading digits to produce the first digit of the result
+				int read = 0;
+				int write = 0;
+				uint64_t n = 0;
+				for (; (n >> shift) == 0; ++read)
 				{
-					// Since this cell is double-quote delimited, proceed without checking delimiters until
-					// we see another double quote character.
-					if (c == '"')
+					if (read >= m_count)
 					{
-						// Advance the iterator and check to see if it's followed by the end of file or
-						// delimiters.  If so, we're done parsing.  If not, a second double-quote should
-						// follow.
-						++current;
-						if (current == text.end() || *current == delimiter || IsLineEnd(current))
-							break;
-						// If this assert hits, your data is malformed, since an interior double-quote was not
-						// followed by a second quote
-						assert(*current == '"');
+						for (; (n >> shift) == 0; ++read)
+							n *= 10;
+						break;
 					}
+					n = n * 10 + m_digits[read];
 				}
-				else
+				m_point -= read - 1;
+				const uint64_t mask = (uint64_t(1) << shift) - 1;
+				for (; read < m_count; ++read)
 				{
-					// This isn't a quote-escaped cell, so check for normal delimiters
-					if (c == delimiter || IsLineEnd(current))
-						break;
+					m_digits[write++] = static_cast<uint8_t>(n >> shift);
+					n = (n & mask) * 10 + m_digits[read];
 				}
-				str += c;
-				++current;
+				for (; n > 0; n = (n & mask) * 10)
+				{
+					if (write < MaxDigits)
+						m_digits[write++] = static_cast<uint8_t>(n >> shift);
+					else if ((n >> shift) > 0)
+						m_truncated = true;
+				}
+				m_count = write;
+				Trim();
 			}
-			return str;
-		}
 
-		bool ReadHeader(std::string_view text, std::string_view::const_iterator & current, char delimiter)
-		{
-			while (current != text.end())
+			// Returns true if the digits should round up when cut at the given digit, rounding
+			// exact ties to even
+			bool ShouldRoundUp(int64_t digit) const
 			{
-				auto str = ParseCell(text, delimiter, current);
-				m_columnMap.insert({ str, m_columnMap.size() });
-				if (IsLineEnd(current))
-					break;
-				++current;
+				if (digit < 0 || digit >= m_count)
+					return false;
+				if (m_digits[digit] == 5 && digit + 1 == m_count)
+					return m_truncated || (digit > 0 && m_digits[digit - 1] % 2 == 1);
+				return m_digits[digit] >= 5;
 			}
-			AdvanceToNextLine(text, current);
-			return true;
-		}
 
-		bool ReadRow(std::string_view text, std::string_view::const_iterator & current, char delimiter, Format format)
+			uint64_t RoundedInteger() const
+			{
+				uint64_t n = 0;
+				int64_t digit = 0;
+				for (; digit < m_point && digit < m_count; ++digit)
+					n = n * 10 + m_digits[digit];
+				for (; digit < m_point; ++digit)
+					n *= 10;
+				return ShouldRoundUp(m_point) ? n + 1 : n;
+			}
+
+			uint8_t m_digits[MaxDigits];
+			int m_count = 0;
+			int64_t m_point = 0;
+			bool m_truncated = false;
+		};
+
+		// Classifies and converts a number in a single pass over the text, without depending on
+		// the current locale.  Integers are digits with an optional sign and leading whitespace,
+		// and must fit in an int64_t.  Anything else is parsed as a decimal floating point number
+		// surrounded by optional whitespace, where either '.' or the given decimal point may
+		// separate the fraction.  Numbers with at most 19 significant digits that fit exactly in
+		// a double, scaled by an exactly representable power of ten, are computed directly with a
+		// single correctly rounded operation (Clinger's fast path).  Anything else is converted with
+		// the Eisel-Lemire algorithm, falling back to exact decimal arithmetic in the rare cases it
+		// can't decide, so every result is correctly rounded on every platform.
+		inline NumberType ParseNumber(std::string_view str, char decimalPoint, int64_t & intValue, double & value)
 		{
-			// Track column data
-			size_t column = 0;
-			while (current != text.end())
+			const char * current = str.data();
+			const char * end = current + str.size();
+			while (current != end && IsSpace(*current))
+				++current;
+			const bool trailingSpace = end != current && IsSpace(*(end - 1));
+			while (end != current && IsSpace(*(end - 1)))
+				--end;
+			const char * begin = current;
+			bool negative = false;
+			if (current != end && (*current == '-' || *current == '+'))
+				negative = *current++ == '-';
+
+			// Accumulate up to 19 significant digits, and track the decimal exponent of the rest
+			uint64_t mantissa = 0;
+			int64_t exponent = 0;
+			size_t digitCount = 0;
+			size_t significantCount = 0;
+			bool truncated = false;
+			auto addDigit = [&](uint64_t digit, bool fraction)
 			{
-				auto str = ParseCell(text, delimiter, current);
-				if (column == 0)
+				++digitCount;
+				if (significantCount == 0 && digit == 0)
+				{
+					// Leading zeros aren't significant
+					if (fraction)
+						--exponent;
+				}
+				else if (significantCount < 19)
 				{
-					m_rowMap.insert({ str, m_rowMap.size() });
-					m_tableData.push_back(str);
+					mantissa = mantissa * 10 + digit;
+					++significantCount;
+					if (fraction)
+						--exponent;
 				}
 				else
-					m_tableData.push_back(ParseData(str, format));
-				++column;
-				if (current == text.end() || IsLineEnd(current))
-					break;
+				{
+					truncated |= digit != 0;
+					if (!fraction)
+						++exponent;
+				}
+			};
+			for (; current != end && *current >= '0' && *current <= '9'; ++current)
+				addDigit(*current - '0', false);
+			if (current == end && digitCount != 0 && !trailingSpace && !truncated && exponent == 0)
+			{
+				// Plain digits are an integer if they fit, with one extra value for negative numbers
+				const uint64_t limit = uint64_t(INT64_MAX) + (negative ? 1 : 0);
+				if (mantissa <= limit)
+				{
+					intValue = negative ? static_cast<int64_t>(0 - mantissa) : static_cast<int64_t>(mantissa);
+					return NumberType::Integer;
+				}
+			}
+			if (current != end && (*current == '.' || *current == decimalPoint))
+			{
+				for (++current; current != end && *current >= '0' && *current <= '9'; ++current)
+					addDigit(*current - '0', true);
+			}
+			if (digitCount == 0)
+				return NumberType::None;
+			if (current != end && (*current == 'e' || *current == 'E'))
+			{
 				++current;
+				bool negativeExponent = false;
+				if (current != end && (*current == '-' || *current == '+'))
+					negativeExponent = *current++ == '-';
+				if (current == end)
+					return NumberType::None;
+				int64_t explicitExponent = 0;
+				for (; current != end && *current >= '0' && *current <= '9'; ++current)
+				{
+					if (explicitExponent < 100000)
+						explicitExponent = explicitExponent * 10 + (*current - '0');
+				}
+				exponent += negativeExponent ? -explicitExponent : explicitExponent;
+			}
+			if (current != end)
+				return NumberType::None;
+
+			static constexpr double PowersOfTen[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+			};
+			if (mantissa == 0)
+			{
+				value = negative ? -0.0 : 0.0;
+				return NumberType::Double;
+			}
+			if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+			{
+				value = static_cast<double>(mantissa);
+				value = exponent < 0 ? value / PowersOfTen[-exponent] : value * PowersOfTen[exponent];
+				value = negative ? -value : value;
+				return NumberType::Double;
 			}
-			AdvanceToNextLine(text, current);
-			return column == GetNumColumns();
+
+			// Otherwise, use the Eisel-Lemire algorithm.  If digits were truncated, the number lies
+			// between the mantissa and the next integer, so the result is only used if both round to
+			// the same double.  If not, the digits are read again and converted exactly.
+			uint64_t bits = ComputeDouble(mantissa, exponent);
+			if (truncated && bits != ComputeDouble(mantissa + 1, exponent))
+				bits = Decimal(begin, end, decimalPoint).ToDouble();
+
+			// Numbers too large or too small to be represented aren't converted
+			if (bits == 0 || bits >= InfinityBits)
+				return NumberType::None;
+			bits |= negative ? uint64_t(1) << 63 : 0;
+			std::memcpy(&value, &bits, sizeof(value));
+			return NumberType::Double;
 		}
 
-		bool ReadRows(std::string_view text, std::string_view::const_iterator & current, char delimiter, Format format)
+		// Parses any number as a double
+		inline bool ParseDouble(std::string_view str, char decimalPoint, double & value)
 		{
-			while (current != text.end())
+			int64_t intValue = 0;
+			switch (ParseNumber(str, decimalPoint, intValue, value))
 			{
-				if (!ReadRow(text, current, delimiter, format))
-					return false;
+				case NumberType::Integer: value = static_cast<double>(intValue); return true;
+				case NumberType::Double: return true;
+				default: return false;
 			}
-			return true;
 		}
 
-		bool Read(std::string_view text)
+		// Formats a double as the shortest text that parses back to the same value, the same way
+		// on every platform.  Fixed or scientific notation is used, whichever is shorter, like
+		// std::to_chars.
+		inline std::string FormatDouble(double value)
 		{
-			char delimiter = 0;
-			Format format = Format::International;
-			if (!DetectDelimiter(text, delimiter, format))
-				return false;
-			std::string_view::const_iterator current = text.begin();
-			if (!ReadHeader(text, current, delimiter))
+			if (std::isnan(value))
+				return "nan";
+			std::string text = std::signbit(value) ? "-" : "";
+			if (std::isinf(value))
+				return text + "inf";
+			if (value == 0.0)
+				return text + "0";
+
+			// Find the fewest digits that parse back to the same value
+			uint64_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			const uint64_t fraction = bits & ((uint64_t(1) << 52) - 1);
+			const int exponent = static_cast<int>((bits >> 52) & 0x7ff);
+			const Decimal exact(exponent ? fraction | (uint64_t(1) << 52) : fraction, (exponent ? exponent : 1) - 1075);
+			std::string digits;
+			int64_t point = 0;
+			for (int count = 1; count <= 17; ++count)
+			{
+				digits = exact.Round(count, point);
+				double parsed = 0.0;
+				if (ParseDouble("0." + digits + "e" + std::to_string(point), '.', parsed) && parsed == std::fabs(value))
+					break;
+			}
+
+			const int64_t digitCount = static_cast<int64_t>(digits.size());
+			const int64_t scientificExponent = point - 1;
+			const int64_t exponentDigits = std::max<int64_t>(2, static_cast<int64_t>(std::to_string(std::abs(scientificExponent)).size()));
+			const int64_t scientificSize = digitCount + (digitCount > 1 ? 1 : 0) + 2 + exponentDigits;
+			const int64_t fixedSize = point <= 0 ? 2 - point + digitCount : point >= digitCount ? point : digitCount + 1;
+			if (fixedSize <= scientificSize)
+			{
+				if (point <= 0)
+					text += "0." + std::string(static_cast<size_t>(-point), '0') + digits;
+				else if (point >= digitCount)
+				{
+					// Integers are written exactly, rather than padding the shortest digits
+					digits = exact.Round(static_cast<int>(point), point);
+					text += digits + std::string(static_cast<size_t>(point) - digits.size(), '0');
+				}
+				else
+					text += digits.substr(0, static_cast<size_t>(point)) + "." + digits.substr(static_cast<size_t>(point));
+				return text;
+			}
+			text += digits.substr(0, 1);
+			if (digitCount > 1)
+				text += "." + digits.substr(1);
+			text += scientificExponent < 0 ? "e-" : "e+";
+			const std::string exponentText = std::to_string(std::abs(scientificExponent));
+			return text + std::string(static_cast<size_t>(exponentDigits) - exponentText.size(), '0') + exponentText;
+		}
+
+		// Number formats, which differ by their decimal point
+		enum class Format
+		{
+			International,
+			Continental
+		};
+
+		inline bool IsLineEnd(char c)
+		{
+			return c == '\n' || c == '\r';
+		}
+
+		inline void AdvanceToNextLine(std::string_view text, size_t & pos)
+		{
+			while (pos < text.size())
+			{
+				if (!IsLineEnd(text[pos]))
+					break;
+				++pos;
+			}
+		}
+
+		inline bool DetectDelimiter(std::string_view text, char & delimiter, Format & format)
+		{
+			size_t tabCount = 0;
+			size_t commaCount = 0;
+			size_t semicolonCount = 0;
+			auto current = text.begin();
+			while (current != text.end())
+			{
+				const char c = *current;
+				if (c == ',')
+					++commaCount;
+				else if (c == '\t')
+					++tabCount;
+				else if (c == ';')
+					++semicolonCount;
+				else if (IsLineEnd(c))
+					break;
+				++current;
+			}
+			if (tabCount == 0 && commaCount == 0 && semicolonCount == 0)
+				return false;
+			delimiter = (commaCount >= tabCount) ? ((commaCount > semicolonCount) ? ',' : ';') : '\t';
+			format = delimiter == ';' ? Format::Continental : Format::International;
+			return true;
+		}
+
+		// A cell's raw text, which still contains doubled quotes if the cell was escaped
+		struct Cell
+		{
+			std::string_view text;
+			bool escaped = false;
+		};
+
+		template<typename S>
+		void AppendUnescaped(S & str, std::string_view text)
+		{
+			str.reserve(str.size() + text.size());
+			for (size_t i = 0; i < text.size(); ++i)
+			{
+				// Each quote inside an escaped cell is followed by a second quote, which is dropped
+				str += text[i];
+				if (text[i] == '"')
+					++i;
+			}
+		}
+
+		// Numbers begin with whitespace, a sign, a digit, or a decimal point.  Anything else
+		// can't be parsed as a number, so we can skip the attempt.
+		inline bool IsNumberStart(char c)
+		{
+			return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || IsSpace(c);
+		}
+
+		// Classifies and converts a cell in a single pass, so text cells are only scanned until
+		// their first character that can't be part of a number.
+		inline NumberType ParseNumber(const Cell & cell, Format format, int64_t & intValue, double & doubleValue)
+		{
+			// Escaped cells always contain a double quote, so they are never numbers
+			if (cell.escaped || (!cell.text.empty() && !IsNumberStart(cell.text[0])))
+				return NumberType::None;
+			// Empty cells have always been read as zero
+			if (cell.text.empty())
+			{
+				intValue = 0;
+				return NumberType::Integer;
+			}
+			return ParseNumber(cell.text, format == Format::Continental ? ',' : '.', intValue, doubleValue);
+		}
+
+		inline Cell ParseCell(Scanner & scanner, size_t & pos, bool & malformed)
+		{
+			std::string_view text = scanner.GetText();
+
+			// If this cell isn't double-quoted, it simply runs to the next delimiter or line end
+			if (text[pos] != '"')
+			{
+				const size_t end = scanner.FindCellEnd(pos);
+				Cell cell{ text.substr(pos, end - pos) };
+				pos = end;
+				return cell;
+			}
+			++pos;
+
+			// Since this cell is double-quote delimited, proceed without checking delimiters until
+			// we see another double quote character.
+			const size_t start = pos;
+			Cell cell;
+			while (pos < text.size())
+			{
+				pos = scanner.FindQuote(pos);
+				cell.text = text.substr(start, pos - start);
+				if (pos == text.size())
+					break;
+
+				// Advance past the quote and check to see if it's followed by the end of file or
+				// delimiters.  If so, we're done parsing.  If not, a second double-quote should
+				// follow.
+				++pos;
+				if (pos == text.size() || text[pos] == scanner.GetDelimiter() || IsLineEnd(text[pos]))
+					break;
+				if (text[pos] != '"')
+					malformed = true;
+				cell.escaped = true;
+				++pos;
+			}
+			return cell;
+		}
+
+		// Fast checksum used to validate binary snapshots, processing eight bytes at a time
+		inline uint64_t Checksum(const char * data, size_t size)
+		{
+			uint64_t hash = 0xcbf29ce484222325ull;
+			size_t i = 0;
+			for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+			{
+				uint64_t word;
+				std::memcpy(&word, data + i, sizeof(word));
+				hash = (hash ^ word) * 0x100000001b3ull;
+				hash ^= hash >> 29;
+			}
+			for (; i < size; ++i)
+				hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+			return hash;
+		}
+
+		// Array is a contiguous array that either owns its values, or views values stored
+		// elsewhere, such as in a memory-mapped snapshot.  Only owned values can be modified.
+		template<typename T, typename Alloc>
+		class Array
+		{
+		public:
+			using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+
+			Array() = default;
+			Array(Vector && values) : m_values(std::move(values)) {}
+
+			static Array View(const T * values, size_t size)
+			{
+				Array array;
+				array.m_view = values;
+				array.m_viewSize = size;
+				return array;
+			}
+
+			const T * data() const { return m_view ? m_view : m_values.data(); }
+			size_t size() const { return m_view ? m_viewSize : m_values.size(); }
+			bool empty() const { return size() == 0; }
+			const T * begin() const { return data(); }
+			const T * end() const { return data() + size(); }
+			const T & operator [] (size_t index) const { assert(index < size()); return data()[index]; }
+
+			Vector & Values() { assert(!m_view); return m_values; }
+			void push_back(const T & value) { Values().push_back(value); }
+			void reserve(size_t size) { Values().reserve(size); }
+
+		private:
+			Vector m_values;
+			const T * m_view = nullptr;
+			size_t m_viewSize = 0;
+		};
+
+		// Binary snapshot header.  The checksum covers all data following the header.
+		struct SnapshotHeader
+		{
+			static const uint32_t Magic = 0x534c4254; // "TBLS"
+			static const uint32_t Version = 2;
+			static const uint32_t ByteOrder = 0x01020304;
+
+			uint32_t magic = Magic;
+			uint32_t version = Version;
+			uint32_t byteOrder = ByteOrder;
+			uint32_t reserved = 0;
+			uint64_t columnCount = 0;
+			uint64_t poolOffset = 0;
+			uint64_t poolSize = 0;
+			uint64_t checksum = 0;
+		};
+
+		// Each snapshot column is described by this header, followed by the column's data.  A
+		// column's strings are stored as pool references, and encoded columns store their codes
+		// and dictionary as well.
+		struct SnapshotColumn
+		{
+			uint64_t type = 0;
+			uint64_t size = 0;
+			uint64_t stringCount = 0;
+			uint64_t encoded = 0;
+		};
+
+		// Each name map is described by this header, followed by the map's arrays
+		struct SnapshotMap
+		{
+			uint64_t keyDataSize = 0;
+			uint64_t entryCount = 0;
+			uint64_t seedCount = 0;
+			uint64_t remapCount = 0;
+			uint64_t slotCount = 0;
+			uint64_t hashSeed = 0;
+		};
+
+		// A string stored in a snapshot's string pool
+		struct SnapshotString
+		{
+			uint64_t offset;
+			uint64_t size;
+		};
+
+		// A mixed cell stored in a snapshot, holding a number or the index of one of its
+		// column's strings
+		struct SnapshotMixedCell
+		{
+			uint64_t value;
+			uint32_t type;
+			uint32_t padding;
+		};
+
+		// Every array in a snapshot starts on an eight byte boundary, so it can be used in place
+		const size_t SnapshotAlignment = 8;
+
+		// Appends plain data to a snapshot, padding each array to the snapshot alignment
+		template<typename String>
+		class SnapshotWriter
+		{
+		public:
+			explicit SnapshotWriter(String & data) : m_data(data) {}
+
+			template<typename T>
+			void Write(const T & value)
+			{
+				static_assert(sizeof(T) % SnapshotAlignment == 0, "Snapshot values must preserve alignment");
+				m_data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+			}
+
+			template<typename T>
+			void WriteArray(const T * values, size_t count)
+			{
+				if (count)
+					m_data.append(reinterpret_cast<const char *>(values), count * sizeof(T));
+				m_data.append((SnapshotAlignment - m_data.size() % SnapshotAlignment) % SnapshotAlignment, '\0');
+			}
+
+		private:
+			String & m_data;
+		};
+
+		// Reads plain data from a snapshot, failing rather than reading past the end.  Arrays are
+		// viewed in place if requested and the snapshot is aligned, and copied otherwise.
+		class SnapshotReader
+		{
+		public:
+			SnapshotReader(std::string_view data, bool inPlace) :
+				m_data(data),
+				m_inPlace(inPlace && reinterpret_cast<uintptr_t>(data.data()) % SnapshotAlignment == 0)
+			{
+			}
+
+			template<typename T>
+			bool Read(T & value)
+			{
+				if (m_data.size() - m_pos < sizeof(T))
+					return false;
+				std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+				m_pos += sizeof(T);
+				return true;
+			}
+
+			template<typename T, typename Alloc>
+			bool ReadArray(Array<T, Alloc> & values, uint64_t count)
+			{
+				static_assert(alignof(T) <= SnapshotAlignment, "Snapshot arrays must be aligned");
+				if (count > (m_data.size() - m_pos) / sizeof(T))
+					return false;
+				const size_t size = static_cast<size_t>(count) * sizeof(T);
+				const size_t padding = (SnapshotAlignment - size % SnapshotAlignment) % SnapshotAlignment;
+				if (m_data.size() - m_pos - size < padding)
+					return false;
+				if (m_inPlace)
+					values = Array<T, Alloc>::View(reinterpret_cast<const T *>(m_data.data() + m_pos), static_cast<size_t>(count));
+				else
+				{
+					typename Array<T, Alloc>::Vector copy(static_cast<size_t>(count));
+					if (size)
+						std::memcpy(copy.data(), m_data.data() + m_pos, size);
+					values = std::move(copy);
+				}
+				m_pos += size + padding;
+				return true;
+			}
+
+			size_t GetPosition() const { return m_pos; }
+
+		private:
+			std::string_view m_data;
+			size_t m_pos = 0;
+			bool m_inPlace;
+		};
+
+		inline size_t GetThreadCount(size_t threads)
+		{
+			if (threads == 0)
+				threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+			return threads;
+		}
+
+		// Calls func(index) for every index in [0, count), distributing the work across up to
+		// the requested number of threads.  The calling thread participates in the work.
+		template<typename Func>
+		void ParallelFor(size_t count, size_t threads, Func func)
+		{
+			threads = std::min(GetThreadCount(threads), count);
+			if (threads <= 1)
+			{
+				for (size_t i = 0; i < count; ++i)
+					func(i);
+				return;
+			}
+			// If func throws, remaining work is abandoned, and the first exception is rethrown on the
+			// calling thread once every worker has finished
+			std::atomic<size_t> next(0);
+			std::atomic<bool> failed(false);
+			std::exception_ptr exception;
+			auto worker = [&]()
+			{
+				try
+				{
+					for (size_t i = next++; i < count; i = next++)
+						func(i);
+				}
+				catch (...)
+				{
+					if (!failed.exchange(true))
+						exception = std::current_exception();
+					next = count;
+				}
+			};
+			std::vector<std::thread> workers;
+			workers.reserve(threads - 1);
+			for (size_t i = 1; i < threads; ++i)
+				workers.emplace_back(worker);
+			worker();
+			for (auto & thread : workers)
+				thread.join();
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+
+		// Returns the sum of an array of integers as a double, however large.  Integers are split
+		// into their high and low 32-bit halves, whose sums can't overflow for up to 2^32 integers.
+		inline double SumIntHalves(const int64_t * values, size_t count)
+		{
+			int64_t high = 0;
+			uint64_t low = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				high += values[i] >> 32;
+				low += static_cast<uint64_t>(values[i]) & 0xffffffff;
+			}
+			return static_cast<double>(high) * 4294967296.0 + static_cast<double>(low);
+		}
+
+		// Returns the sum of an array of integers as a double.  Integers are summed in 64 bits,
+		// recording whether any addition overflowed, in which case they're summed again by halves.
+		inline double SumInts(const int64_t * values, size_t count)
+		{
+			size_t i = 0;
+			uint64_t sum = 0;
+			uint64_t overflow = 0;
+			auto add = [&](uint64_t value)
+			{
+				const uint64_t next = sum + value;
+				overflow |= (sum ^ next) & (value ^ next);
+				sum = next;
+			};
+#if defined(TBL_AVX2)
+			__m256i sums = _mm256_setzero_si256();
+			__m256i overflows = _mm256_setzero_si256();
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+				const __m256i next = _mm256_add_epi64(sums, value);
+				overflows = _mm256_or_si256(overflows, _mm256_and_si256(_mm256_xor_si256(sums, next), _mm256_xor_si256(value, next)));
+				sums = next;
+			}
+			alignas(32) uint64_t lanes[4];
+			alignas(32) uint64_t overflowLanes[4];
+			_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sums);
+			_mm256_store_si256(reinterpret_cast<__m256i *>(overflowLanes), overflows);
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				add(lanes[lane]);
+				overflow |= overflowLanes[lane];
+			}
+#elif defined(TBL_SSE2)
+			__m128i sums = _mm_setzero_si128();
+			__m128i overflows = _mm_setzero_si128();
+			for (; i + 2 <= count; i += 2)
+			{
+				const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+				const __m128i next = _mm_add_epi64(sums, value);
+				overflows = _mm_or_si128(overflows, _mm_and_si128(_mm_xor_si128(sums, next), _mm_xor_si128(value, next)));
+				sums = next;
+			}
+			alignas(16) uint64_t lanes[2];
+			alignas(16) uint64_t overflowLanes[2];
+			_mm_store_si128(reinterpret_cast<__m128i *>(lanes), sums);
+			_mm_store_si128(reinterpret_cast<__m128i *>(overflowLanes), overflows);
+			for (int lane = 0; lane < 2; ++lane)
+			{
+				add(lanes[lane]);
+				overflow |= overflowLanes[lane];
+			}
+#endif
+			for (; i < count; ++i)
+				add(static_cast<uint64_t>(values[i]));
+			if (overflow >> 63)
+				return SumIntHalves(values, count);
+			return static_cast<double>(static_cast<int64_t>(sum));
+		}
+
+		// Returns the sum of an array of doubles, accumulated in several independent lanes
+		inline double SumDoubles(const double * values, size_t count)
+		{
+			size_t i = 0;
+			double sum = 0.0;
+#if defined(TBL_AVX2)
+			__m256d sums0 = _mm256_setzero_pd();
+			__m256d sums1 = _mm256_setzero_pd();
+			for (; i + 8 <= count; i += 8)
+			{
+				sums0 = _mm256_add_pd(sums0, _mm256_loadu_pd(values + i));
+				sums1 = _mm256_add_pd(sums1, _mm256_loadu_pd(values + i + 4));
+			}
+			alignas(32) double lanes[4];
+			_mm256_store_pd(lanes, _mm256_add_pd(sums0, sums1));
+			sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(TBL_SSE2)
+			__m128d sums0 = _mm_setzero_pd();
+			__m128d sums1 = _mm_setzero_pd();
+			for (; i + 4 <= count; i += 4)
+			{
+				sums0 = _mm_add_pd(sums0, _mm_loadu_pd(values + i));
+				sums1 = _mm_add_pd(sums1, _mm_loadu_pd(values + i + 2));
+			}
+			alignas(16) double lanes[2];
+			_mm_store_pd(lanes, _mm_add_pd(sums0, sums1));
+			sum = lanes[0] + lanes[1];
+#endif
+			for (; i < count; ++i)
+				sum += values[i];
+			return sum;
+		}
+
+		// Returns the smallest or largest of a non-empty array of integers
+		template<bool IsMax>
+		int64_t LimitInts(const int64_t * values, size_t count)
+		{
+			assert(count > 0);
+			size_t i = 0;
+			int64_t limit = values[0];
+#if defined(TBL_AVX2)
+			if (count >= 4)
+			{
+				__m256i limits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+				for (i = 4; i + 4 <= count; i += 4)
+				{
+					const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+					const __m256i greater = _mm256_cmpgt_epi64(next, limits);
+					limits = IsMax ? _mm256_blendv_epi8(limits, next, greater) : _mm256_blendv_epi8(next, limits, greater);
+				}
+				alignas(32) int64_t lanes[4];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), limits);
+				for (int64_t lane : lanes)
+					limit = IsMax ? std::max(limit, lane) : std::min(limit, lane);
+			}
+#endif
+			for (; i < count; ++i)
+				limit = IsMax ? std::max(limit, values[i]) : std::min(limit, values[i]);
+			return limit;
+		}
+
+		// Returns the smallest or largest of a non-empty array of doubles
+		template<bool IsMax>
+		double LimitDoubles(const double * values, size_t count)
+		{
+			assert(count > 0);
+			size_t i = 0;
+			double limit = values[0];
+#if defined(TBL_AVX2)
+			if (count >= 4)
+			{
+				__m256d limits = _mm256_loadu_pd(values);
+				for (i = 4; i + 4 <= count; i += 4)
+				{
+					const __m256d next = _mm256_loadu_pd(values + i);
+					limits = IsMax ? _mm256_max_pd(limits, next) : _mm256_min_pd(limits, next);
+				}
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, limits);
+				for (double lane : lanes)
+					limit = IsMax ? std::max(limit, lane) : std::min(limit, lane);
+			}
+#elif defined(TBL_SSE2)
+			if (count >= 2)
+			{
+				__m128d limits = _mm_loadu_pd(values);
+				for (i = 2; i + 2 <= count; i += 2)
+				{
+					const __m128d next = _mm_loadu_pd(values + i);
+					limits = IsMax ? _mm_max_pd(limits, next) : _mm_min_pd(limits, next);
+				}
+				alignas(16) double lanes[2];
+				_mm_store_pd(lanes, limits);
+				for (double lane : lanes)
+					limit = IsMax ? std::max(limit, lane) : std::min(limit, lane);
+			}
+#endif
+			for (; i < count; ++i)
+				limit = IsMax ? std::max(limit, values[i]) : std::min(limit, values[i]);
+			return limit;
+		}
+
+	}
+
+	// Types of data stored in a table column.  Columns containing more than one type of
+	// data are mixed, and store each cell as a compact tagged union.
+	enum class ColumnType
+	{
+		Empty,
+		Integer,
+		Double,
+		String,
+		Mixed
+	};
+
+	// Arena is a monotonic allocator.  Memory is handed out from large slabs, and individual
+	// allocations are never freed.  Instead, all slabs are freed at once when the arena is
+	// destroyed.  An arena isn't thread-safe, but can own child arenas for use by other threads.
+	class Arena
+#ifdef TBL_PMR
+		: public std::pmr::memory_resource
+#endif
+	{
+	public:
+		static constexpr size_t MinSlabSize = 64 * 1024;
+		static constexpr size_t MaxSlabSize = 16 * 1024 * 1024;
+
+		Arena() = default;
+		Arena(const Arena &) = delete;
+		Arena & operator = (const Arena &) = delete;
+
+		~Arena()
+		{
+			while (m_slab)
+			{
+				Slab * next = m_slab->next;
+				::operator delete(m_slab);
+				m_slab = next;
+			}
+		}
+
+		void * Allocate(size_t size, size_t alignment)
+		{
+			assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+			size_t offset = AlignedOffset(alignment);
+			if (!m_slab || offset > m_slab->size || size > m_slab->size - offset)
+			{
+				AddSlab(size + alignment);
+				offset = AlignedOffset(alignment);
+			}
+			m_used = offset + size;
+			return reinterpret_cast<char *>(m_slab) + offset;
+		}
+
+		// Creates an arena that lives as long as this one, for use by another thread
+		Arena & CreateChild()
+		{
+			m_children.push_back(std::make_unique<Arena>());
+			m_children.back()->m_owner = GetOwner();
+			return *m_children.back();
+		}
+
+		// Returns the arena that owns this one, or this arena if it isn't a child.  Memory from
+		// arenas with the same owner is freed at the same time.
+		const Arena * GetOwner() const { return m_owner ? m_owner : this; }
+
+		// Returns the number of bytes reserved by this arena and its children
+		size_t GetSize() const
+		{
+			size_t size = 0;
+			for (const Slab * slab = m_slab; slab; slab = slab->next)
+				size += slab->size;
+			for (const auto & child : m_children)
+				size += child->GetSize();
+			return size;
+		}
+
+		// Returns the arena used by ArenaAllocators constructed on the calling thread, or null
+		// if they should use the heap
+		static Arena * GetCurrent() { return Current(); }
+
+		// Scope directs ArenaAllocators constructed on the calling thread to an arena for as long
+		// as it exists
+		class Scope
+		{
+		public:
+			explicit Scope(Arena * arena) : m_previous(Current()) { Current() = arena; }
+			~Scope() { Current() = m_previous; }
+			Scope(const Scope &) = delete;
+			Scope & operator = (const Scope &) = delete;
+
+		private:
+			Arena * m_previous;
+		};
+
+	private:
+		// Each slab begins with this header, followed by the memory it hands out
+		struct Slab
+		{
+			Slab * next;
+			size_t size;
+		};
+
+		static Arena *& Current()
+		{
+			thread_local Arena * current = nullptr;
+			return current;
+		}
+
+		size_t AlignedOffset(size_t alignment) const
+		{
+			const uintptr_t base = reinterpret_cast<uintptr_t>(m_slab);
+			return static_cast<size_t>(((base + m_used + alignment - 1) & ~uintptr_t(alignment - 1)) - base);
+		}
+
+		void AddSlab(size_t minSize)
+		{
+			// Slabs double in size as the arena grows, and very large allocations get a slab of their own
+			m_slabSize = std::min(std::max(m_slabSize * 2, MinSlabSize), MaxSlabSize);
+			const size_t size = std::max(m_slabSize, minSize + sizeof(Slab));
+			Slab * slab = static_cast<Slab *>(::operator new(size));
+			slab->next = m_slab;
+			slab->size = size;
+			m_slab = slab;
+			m_used = sizeof(Slab);
+		}
+
+#ifdef TBL_PMR
+		void * do_allocate(size_t size, size_t alignment) override { return Allocate(size, alignment); }
+		void do_deallocate(void *, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override { return this == &other; }
+#endif
+
+		Slab * m_slab = nullptr;
+		size_t m_used = 0;
+		size_t m_slabSize = 0;
+		const Arena * m_owner = nullptr;
+		std::vector<std::unique_ptr<Arena>> m_children;
+	};
+
+	// ArenaAllocator allocates from the arena that was current on the thread that constructed
+	// it, or from the heap if there was none.  Tables using this allocator own an arena, so all
+	// memory for their cells, strings and indices is freed at once with the table.  Allocators
+	// are only equal if they use the same arena, or children of the same arena, since only then
+	// is their memory freed at the same time.
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::false_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		ArenaAllocator() : m_arena(Arena::GetCurrent()) {}
+		explicit ArenaAllocator(Arena * arena) : m_arena(arena) {}
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U> & other) : m_arena(other.GetArena()) {}
+
+		T * allocate(size_t count)
+		{
+			if (!m_arena)
+				return std::allocator<T>().allocate(count);
+			assert(count <= SIZE_MAX / sizeof(T));
+			return static_cast<T *>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+		}
+		void deallocate(T * data, size_t count)
+		{
+			if (!m_arena)
+				std::allocator<T>().deallocate(data, count);
+		}
+
+		// Copies of a container allocate from the current arena, rather than the original's arena
+		ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+		Arena * GetArena() const { return m_arena; }
+
+		template<typename U>
+		bool operator == (const ArenaAllocator<U> & other) const
+		{
+			return m_arena == other.GetArena() || (m_arena && other.GetArena() && m_arena->GetOwner() == other.GetArena()->GetOwner());
+		}
+		template<typename U>
+		bool operator != (const ArenaAllocator<U> & other) const { return !(*this == other); }
+
+	private:
+		Arena * m_arena;
+	};
+
+	namespace Detail
+	{
+		template<typename Alloc>
+		struct IsArenaAllocator : std::false_type {};
+		template<typename T>
+		struct IsArenaAllocator<ArenaAllocator<T>> : std::true_type {};
+
+		// StringIndexMap maps names to indices.  It's built once from a complete list of keys as a
+		// minimal perfect hash over a flat array of keys, so each lookup needs only one hash, one
+		// probe, and one key comparison, and lookups can be made using a std::string_view without
+		// constructing a temporary String.
+		template<typename Alloc>
+		class StringIndexMap
+		{
+			using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+			template<typename T>
+			using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+		public:
+			static const size_t NotFound = SIZE_MAX;
+
+			// Builds the map using hash and displace.  Keys are hashed into buckets, and each bucket,
+			// largest first, searches for a seed that places all its keys in free slots.  Slightly
+			// more slots than keys are used to keep seed searches short, and keys placed past the
+			// end are then remapped into the remaining free slots.  Each unique key maps to the
+			// position of its first appearance in the list, and later duplicates are ignored.
+			// Returns false, leaving the map empty, if a perfect hash could not be found for the keys.
+			bool Build(const Vector<std::string_view> & keys)
+			{
+				if (keys.size() >= UINT32_MAX)
+					return false;
+				// Temporary arrays used to build the map are allocated from the heap, not an arena
+				Arena::Scope scope(nullptr);
+				const size_t MaxHashSeeds = 64;
+				for (uint64_t hashSeed = 0; hashSeed < MaxHashSeeds; ++hashSeed)
+				{
+					if (Build(keys, hashSeed))
+						return true;
+				}
+				return false;
+			}
+
+			// Returns the index for a key, or NotFound if the key isn't in the map.  The key's hash
+			// must be computed with HashString using the default seed.
+			size_t Find(std::string_view key, uint64_t hash) const
+			{
+				if (m_entries.empty())
+					return NotFound;
+				if (m_hashSeed != 0)
+					hash = HashString(key, m_hashSeed);
+				size_t slot = GetSlot(hash, m_seeds[GetBucket(hash, m_seeds.size())], m_slotCount);
+				if (slot >= m_entries.size())
+					slot = m_remap[slot - m_entries.size()];
+				const Entry & entry = m_entries[slot];
+				if (std::string_view(m_keyData.data() + entry.offset, entry.size) != key)
+					return NotFound;
+				return entry.value;
+			}
+
+			size_t Size() const { return m_entries.size(); }
+
+			// Calls func(key, index) for each key in the map
+			template<typename Func>
+			void ForEach(Func func) const
+			{
+				for (const Entry & entry : m_entries)
+					func(std::string_view(m_keyData.data() + entry.offset, entry.size), size_t(entry.value));
+			}
+
+			// Writes the map to a snapshot, so it can be read again without being rebuilt
+			template<typename String>
+			void Write(SnapshotWriter<String> & writer) const
+			{
+				SnapshotMap header;
+				header.keyDataSize = m_keyData.size();
+				header.entryCount = m_entries.size();
+				header.seedCount = m_seeds.size();
+				header.remapCount = m_remap.size();
+				header.slotCount = m_slotCount;
+				header.hashSeed = m_hashSeed;
+				writer.Write(header);
+				writer.WriteArray(m_keyData.data(), m_keyData.size());
+				writer.WriteArray(m_entries.data(), m_entries.size());
+				writer.WriteArray(m_seeds.data(), m_seeds.size());
+				writer.WriteArray(m_remap.data(), m_remap.size());
+			}
+
+			// Reads a map written to a snapshot.  The map is validated so that every lookup stays
+			// within its arrays and returns an index less than valueCount.
+			bool Read(SnapshotReader & reader, size_t valueCount)
+			{
+				SnapshotMap header;
+				if (!reader.Read(header) || !reader.ReadArray(m_keyData, header.keyDataSize) ||
+					!reader.ReadArray(m_entries, header.entryCount) || !reader.ReadArray(m_seeds, header.seedCount) ||
+					!reader.ReadArray(m_remap, header.remapCount))
+					return false;
+				if (header.slotCount != header.entryCount + header.remapCount || (!m_entries.empty() && m_seeds.empty()))
+					return false;
+				for (const Entry & entry : m_entries)
+				{
+					if (entry.offset > m_keyData.size() || entry.size > m_keyData.size() - entry.offset || entry.value >= valueCount)
+						return false;
+				}
+				for (uint32_t slot : m_remap)
+				{
+					if (slot >= m_entries.size())
+						return false;
+				}
+				m_slotCount = static_cast<size_t>(header.slotCount);
+				m_hashSeed = header.hashSeed;
+				return true;
+			}
+
+		private:
+			struct Entry
+			{
+				uint64_t offset;
+				uint32_t size;
+				uint32_t value;
+			};
+
+			static size_t GetBucket(uint64_t hash, size_t bucketCount)
+			{
+				return ReduceHash(hash >> 32, bucketCount);
+			}
+
+			static size_t GetSlot(uint64_t hash, uint32_t seed, size_t slotCount)
+			{
+				return ReduceHash(MixHash(hash + seed * 0x9e3779b97f4a7c15ull), slotCount);
+			}
+
+			bool Build(const Vector<std::string_view> & keys, uint64_t hashSeed)
+			{
+				const uint32_t EmptySlot = UINT32_MAX;
+				const uint32_t MaxSeed = 1u << 16;
+				const size_t count = keys.size();
+				const size_t bucketCount = count / 4 + 1;
+
+				// Sort keys by bucket, keeping keys in their original order within each bucket
+				Vector<uint64_t> hashes(count);
+				Vector<uint32_t> bucketStarts(bucketCount + 1, 0);
+				for (size_t key = 0; key < count; ++key)
+				{
+					hashes[key] = HashString(keys[key], hashSeed);
+					++bucketStarts[GetBucket(hashes[key], bucketCount) + 1];
+				}
+				for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+					bucketStarts[bucket + 1] += bucketStarts[bucket];
+				Vector<uint32_t> bucketKeys(count);
+				{
+					Vector<uint32_t> next(bucketStarts.begin(), bucketStarts.end() - 1);
+					for (size_t key = 0; key < count; ++key)
+						bucketKeys[next[GetBucket(hashes[key], bucketCount)]++] = static_cast<uint32_t>(key);
+				}
+
+				// Remove duplicate keys from each bucket, keeping the first appearance
+				Vector<bool> duplicates(count, false);
+				Vector<uint32_t> bucketSizes(bucketCount);
+				for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+				{
+					const auto begin = bucketKeys.begin() + bucketStarts[bucket];
+					const auto end = bucketKeys.begin() + bucketStarts[bucket + 1];
+					std::sort(begin, end, [&](uint32_t a, uint32_t b) { return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : a < b; });
+					for (auto key = begin; key != end; ++key)
+					{
+						for (auto other = key; other != begin && hashes[*(other - 1)] == hashes[*key]; --other)
+						{
+							if (!duplicates[*(other - 1)] && keys[*(other - 1)] == keys[*key])
+							{
+								duplicates[*key] = true;
+								break;
+							}
+						}
+					}
+					auto last = std::remove_if(begin, end, [&](uint32_t key) { return duplicates[key]; });
+					bucketSizes[bucket] = static_cast<uint32_t>(last - begin);
+				}
+				size_t uniqueCount = 0;
+				for (size_t key = 0; key < count; ++key)
+				{
+					if (!duplicates[key])
+						++uniqueCount;
+				}
+
+				// Find a seed for each bucket, largest first, that places its keys in free slots
+				Vector<uint32_t> buckets(bucketCount);
+				for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+					buckets[bucket] = static_cast<uint32_t>(bucket);
+				std::stable_sort(buckets.begin(), buckets.end(), [&](uint32_t a, uint32_t b) { return bucketSizes[a] > bucketSizes[b]; });
+				const size_t uniqueSlotCount = uniqueCount + uniqueCount / 8 + 1;
+				Vector<uint32_t> seeds(bucketCount, 0);
+				Vector<uint32_t> slotKeys(uniqueSlotCount, EmptySlot);
+				for (uint32_t bucket : buckets)
+				{
+					const uint32_t * begin = bucketKeys.data() + bucketStarts[bucket];
+					const uint32_t * end = begin + bucketSizes[bucket];
+					if (begin == end)
+						break;
+					uint32_t seed = 0;
+					for (; seed < MaxSeed; ++seed)
+					{
+						const uint32_t * placed = begin;
+						for (; placed != end; ++placed)
+						{
+							const size_t slot = GetSlot(hashes[*placed], seed, uniqueSlotCount);
+							if (slotKeys[slot] != EmptySlot)
+								break;
+							slotKeys[slot] = *placed;
+						}
+						if (placed == end)
+							break;
+						// Release any slots claimed by this attempt
+						for (const uint32_t * key = begin; key != placed; ++key)
+							slotKeys[GetSlot(hashes[*key], seed, uniqueSlotCount)] = EmptySlot;
+					}
+					if (seed == MaxSeed)
+						return false;
+					seeds[bucket] = seed;
+				}
+
+				// Remap keys placed beyond the key count into the free slots below it
+				Vector<uint32_t> remap(uniqueSlotCount - uniqueCount);
+				size_t freeSlot = 0;
+				for (size_t slot = uniqueCount; slot < uniqueSlotCount; ++slot)
+				{
+					if (slotKeys[slot] == EmptySlot)
+						continue;
+					while (slotKeys[freeSlot] != EmptySlot)
+						++freeSlot;
+					slotKeys[freeSlot] = slotKeys[slot];
+					remap[slot - uniqueCount] = static_cast<uint32_t>(freeSlot);
+				}
+
+				// Store keys in a flat array, ordered by slot
+				size_t keySize = 0;
+				for (size_t slot = 0; slot < uniqueCount; ++slot)
+					keySize += keys[slotKeys[slot]].size();
+				auto & keyData = m_keyData.Values();
+				auto & entries = m_entries.Values();
+				keyData.clear();
+				keyData.reserve(keySize);
+				entries.resize(uniqueCount);
+				for (size_t slot = 0; slot < uniqueCount; ++slot)
+				{
+					const uint32_t key = slotKeys[slot];
+					assert(keys[key].size() < UINT32_MAX);
+					entries[slot] = { keyData.size(), static_cast<uint32_t>(keys[key].size()), key };
+					keyData.insert(keyData.end(), keys[key].begin(), keys[key].end());
+				}
+				m_seeds = std::move(seeds);
+				m_remap = std::move(remap);
+				m_slotCount = uniqueSlotCount;
+				m_hashSeed = hashSeed;
+				return true;
+			}
+
+			Array<char, Alloc> m_keyData;
+			Array<Entry, Alloc> m_entries;
+			Array<uint32_t, Alloc> m_seeds;
+			Array<uint32_t, Alloc> m_remap;
+			size_t m_slotCount = 0;
+			uint64_t m_hashSeed = 0;
+		};
+	}
+
+	// Span is a lightweight view of contiguous, read-only table data
+	template<typename T>
+	class Span
+	{
+	public:
+		Span() = default;
+		Span(const T * data, size_t size) : m_data(data), m_size(size) {}
+
+		const T * begin() const { return m_data; }
+		const T * end() const { return m_data + m_size; }
+		const T * data() const { return m_data; }
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		const T & operator[](size_t index) const
+		{
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+	private:
+		const T * m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	// Name is a row or column name along with its precomputed hash.  Declaring a name as
+	// constexpr computes its hash at compile time, so lookups by that name skip hashing.
+	//   static constexpr Tbl::Name Damage = "Damage";
+	//   double damage = table.Get<double>(rowName, Damage);
+	class Name
+	{
+	public:
+		template<typename T, typename = std::enable_if_t<std::is_convertible_v<const T &, std::string_view>>>
+		constexpr Name(const T & name) : m_name(name), m_hash(Detail::HashString(m_name)) {}
+
+		constexpr std::string_view GetName() const { return m_name; }
+		constexpr uint64_t GetHash() const { return m_hash; }
+
+	private:
+		std::string_view m_name;
+		uint64_t m_hash;
+	};
+
+	// RowView is a lightweight view of some or all of the cells in a single row of text.  Cells
+	// refer to the text being parsed, and are only valid until the function receiving the view
+	// returns.
+	class RowView
+	{
+	public:
+		using TableData = std::variant<int64_t, double, std::string_view>;
+
+		RowView(const Detail::Cell * cells, size_t size, Detail::Format format, size_t nameIndex) :
+			m_cells(cells), m_size(size), m_format(format), m_nameIndex(nameIndex)
+		{
+		}
+
+		size_t GetNumColumns() const { return m_size; }
+
+		// Returns the cell's text, with any escaped double quotes removed
+		std::string_view GetText(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			return m_cells[columnIndex].text;
+		}
+
+		// Returns the cell's data, converted in the same way as a table cell
+		TableData GetData(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			const Detail::Cell & cell = m_cells[columnIndex];
+			int64_t intValue = 0;
+			double doubleValue = 0.0;
+			switch (columnIndex == m_nameIndex ? Detail::NumberType::None : Detail::ParseNumber(cell, m_format, intValue, doubleValue))
+			{
+				case Detail::NumberType::Integer: return intValue;
+				case Detail::NumberType::Double: return doubleValue;
+				default: return cell.text;
+			}
+		}
+
+		template <typename T>
+		T Get(size_t columnIndex) const
+		{
+			return std::get<T>(GetData(columnIndex));
+		}
+
+	private:
+		const Detail::Cell * m_cells;
+		size_t m_size;
+		Detail::Format m_format;
+		// Index of the cell naming the row, which is never read as a number
+		size_t m_nameIndex;
+	};
+
+	// Options controlling how a table is read
+	struct Options
+	{
+		// Number of threads used to parse rows, or zero to use all hardware threads.  Text is
+		// split into chunks at row boundaries, and only text large enough to give each thread
+		// at least MinParallelChunkSize bytes is parsed in parallel.
+		size_t threads = 1;
+
+		// Names of the columns to load, or empty to load every column.  Other columns are skipped
+		// while parsing, and are neither converted nor stored.  The first column is always loaded,
+		// since it names each row, and columns keep the order they have in the text.  If a listed
+		// column isn't found in the header, the table reports an error.
+		std::vector<std::string_view> columns;
+
+		// Function deciding whether to load each row, given a view of the row's cells in the
+		// columns listed in filterColumns, in the order listed.  Filter columns don't need to be
+		// loaded.  Parsing of a row stops once its last filter column is read, and the rest of a
+		// rejected row is skipped without being converted or stored.  When parsing in parallel,
+		// the filter is called concurrently, but only for rows in the text.  It may be called
+		// again for the same row if parallel parsing falls back to a single thread, and anything
+		// it throws is passed on to the caller.  If a filter column isn't found in the header,
+		// the table reports an error.
+		std::vector<std::string_view> filterColumns;
+		std::function<bool(const RowView &)> filter;
+
+		// String columns, other than the first, in which at most this fraction of values are
+		// distinct are dictionary encoded, storing each distinct value once along with a code
+		// for each row.  Only columns with at least MinDictionaryRows rows are encoded, and a
+		// ratio of zero disables encoding.
+		double dictionaryRatio = 0.25;
+
+		static const size_t MinParallelChunkSize = 64 * 1024;
+		static const size_t MinDictionaryRows = 64;
+	};
+
+	// Functions used to aggregate the rows of each group of a table
+	enum class AggregateFunction
+	{
+		Count,
+		Sum,
+		Min,
+		Max,
+		Mean,
+	};
+
+	// Aggregation describes a column of a grouped table, computed from the numeric cells of a
+	// column of the source table.  Count() without a column counts every row.  Result columns
+	// are named after the function and source column, such as "Sum(Gold)", unless named.
+	struct Aggregation
+	{
+		AggregateFunction function;
+		std::string_view column;
+		std::string_view name;
+	};
+
+	inline Aggregation Count(std::string_view column = std::string_view(), std::string_view name = std::string_view())
+	{
+		return { AggregateFunction::Count, column, name };
+	}
+	inline Aggregation Sum(std::string_view column, std::string_view name = std::string_view())
+	{
+		return { AggregateFunction::Sum, column, name };
+	}
+	inline Aggregation Min(std::string_view column, std::string_view name = std::string_view())
+	{
+		return { AggregateFunction::Min, column, name };
+	}
+	inline Aggregation Max(std::string_view column, std::string_view name = std::string_view())
+	{
+		return { AggregateFunction::Max, column, name };
+	}
+	inline Aggregation Mean(std::string_view column, std::string_view name = std::string_view())
+	{
+		return { AggregateFunction::Mean, column, name };
+	}
+
+	template<typename Alloc, typename CellString>
+	class TableSet;
+
+	template<typename Alloc, typename CellString>
+	class JoinView;
+
+	// Table class reads and parses CSV or tab-delimited text.  String cells are stored as
+	// CellString, which is either an owning String or a std::string_view.
+	template<typename Alloc = std::allocator<char>, typename CellString = std::basic_string<char, std::char_traits<char>, Alloc>>
+	class Table
+	{
+	public:
+		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+		using TableData = std::variant<int64_t, double, CellString>;
+		static_assert(std::is_same_v<CellString, String> || std::is_same_v<CellString, std::string_view>, "CellString must be String or std::string_view");
+	private:
+		static constexpr bool OwnsStrings = std::is_same_v<CellString, String>;
+		static constexpr bool UsesArena = Detail::IsArenaAllocator<Alloc>::value;
+		using StringPoolAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<String>;
+		using StringPool = std::list<String, StringPoolAlloc>;
+		template<typename T>
+		using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+		using StringIndexMap = Detail::StringIndexMap<Alloc>;
+	public:
+
+		Table(std::string_view text, const Options & options = Options())
+		{
+			m_error = !Read(text, options);
+		}
+
+		Table(const Table &) = default;
+		Table(Table &&) = default;
+
+		// Assignment swaps with a copy, so a table's arena always outlives the containers using it
+		Table & operator = (Table other)
+		{
+			std::swap(m_arena, other.m_arena);
+			std::swap(m_columns, other.m_columns);
+			std::swap(m_hashIndexes, other.m_hashIndexes);
+			std::swap(m_rangeIndexes, other.m_rangeIndexes);
+			std::swap(m_stringPool, other.m_stringPool);
+			std::swap(m_file, other.m_file);
+			std::swap(m_columnMap, other.m_columnMap);
+			std::swap(m_rowMap, other.m_rowMap);
+			std::swap(m_error, other.m_error);
+			return *this;
+		}
+
+		// Reads a table directly from a memory-mapped file.  If string cells are views, the table
+		// keeps the file mapped for as long as it exists.
+		static Table FromFile(std::string_view path, const Options & options = Options())
+		{
+			return FromMappedFile(std::make_shared<const Detail::MappedFile>(path), options);
+		}
+
+		// Reads a table from a binary snapshot created with ToSnapshot().  If string cells are views,
+		// they refer directly to the snapshot, which must outlive the table, and numeric columns,
+		// codes, and name maps are used in place as well.
+		static Table FromSnapshot(std::string_view snapshot)
+		{
+			Table table;
+			table.m_error = !table.ReadSnapshot(snapshot, !OwnsStrings);
+			return table;
+		}
+
+		// Reads a table from a memory-mapped binary snapshot file.  The table keeps the file mapped
+		// for as long as it exists, and uses everything but owned strings in place.
+		static Table FromSnapshotFile(std::string_view path)
+		{
+			auto file = std::make_shared<const Detail::MappedFile>(path);
+			Table table;
+			table.m_error = !*file || !table.ReadSnapshot(file->GetText(), true);
+			table.m_file = std::move(file);
+			return table;
+		}
+
+		// Serializes the parsed table to a binary snapshot, which can be loaded again without parsing
+		String ToSnapshot() const
+		{
+			assert(!m_error);
+			String pool;
+			String data;
+			Detail::SnapshotWriter<String> writer(data);
+			auto writeStrings = [&](const auto & strings)
+			{
+				Vector<Detail::SnapshotString> refs(strings.size());
+				for (size_t index = 0; index < strings.size(); ++index)
+				{
+					const std::string_view str = strings[index];
+					refs[index] = { pool.size(), str.size() };
+					pool.append(str);
+				}
+				writer.WriteArray(refs.data(), refs.size());
+			};
+
+			m_columnMap.Write(writer);
+			for (const Column & column : m_columns)
+			{
+				Detail::SnapshotColumn header;
+				header.type = static_cast<uint64_t>(column.type);
+				header.size = column.Size();
+				header.stringCount = column.strings.size();
+				header.encoded = column.IsEncoded();
+				writer.Write(header);
+				switch (column.type)
+				{
+					case ColumnType::Integer: writer.WriteArray(column.ints.data(), column.ints.size()); break;
+					case ColumnType::Double: writer.WriteArray(column.doubles.data(), column.doubles.size()); break;
+					case ColumnType::String:
+						if (column.IsEncoded())
+							writer.WriteArray(column.codes.data(), column.codes.size());
+						writeStrings(column.strings);
+						if (column.IsEncoded())
+							column.dictionary.Write(writer);
+						break;
+					case ColumnType::Mixed:
+					{
+						// Cells are copied so that padding is written as zeros
+						Vector<Detail::SnapshotMixedCell> cells(column.mixed.size());
+						for (size_t row = 0; row < cells.size(); ++row)
+						{
+							const MixedCell & cell = column.mixed[row];
+							if (cell.type == ColumnType::Integer)
+								std::memcpy(&cells[row].value, &cell.intValue, sizeof(cell.intValue));
+							else if (cell.type == ColumnType::Double)
+								std::memcpy(&cells[row].value, &cell.doubleValue, sizeof(cell.doubleValue));
+							else
+								cells[row].value = cell.stringIndex;
+							cells[row].type = static_cast<uint32_t>(cell.type);
+							cells[row].padding = 0;
+						}
+						writer.WriteArray(cells.data(), cells.size());
+						writeStrings(column.strings);
+						break;
+					}
+					default:
+						break;
+				}
+			}
+			m_rowMap.Write(writer);
+
+			Detail::SnapshotHeader header;
+			header.columnCount = GetNumColumns();
+			header.poolOffset = sizeof(header) + data.size();
+			header.poolSize = pool.size();
+			String snapshot;
+			snapshot.reserve(header.poolOffset + pool.size());
+			snapshot.append(reinterpret_cast<const char *>(&header), sizeof(header));
+			snapshot.append(data);
+			snapshot.append(pool);
+			header.checksum = Detail::Checksum(snapshot.data() + sizeof(header), snapshot.size() - sizeof(header));
+			std::memcpy(snapshot.data(), &header, sizeof(header));
+			return snapshot;
+		}
+
+		explicit operator bool() const { return !m_error; }
+
+		size_t GetNumColumns() const { return m_columnMap.Size(); }
+		size_t GetNumRows() const { return m_columns.empty() ? 0 : m_columns[0].Size(); }
+		size_t GetRowIndex(const Name & rowName) const
+		{
+			const size_t index = m_rowMap.Find(rowName.GetName(), rowName.GetHash());
+			assert(index != StringIndexMap::NotFound);
+			return index;
+		}
+		size_t GetColumnIndex(const Name & columnName) const
+		{
+			const size_t index = m_columnMap.Find(columnName.GetName(), columnName.GetHash());
+			assert(index != StringIndexMap::NotFound);
+			return index;
+		}
+		ColumnType GetColumnType(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].type;
+		}
+		TableData GetData(size_t rowIndex, size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(rowIndex < GetNumRows());
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].GetData(rowIndex);
+		}
+		TableData GetData(const Name & rowName, const Name & columnName) const
+		{
+			return GetData(GetRowIndex(rowName), GetColumnIndex(columnName));
+		}
+		template <typename T>
+		const T & Get(size_t rowIndex, size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(rowIndex < GetNumRows());
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].template Get<T>(rowIndex);
+		}
+		template <typename T>
+		const T & Get(const Name & rowName, const Name & columnName) const
+		{
+			return Get<T>(GetRowIndex(rowName), GetColumnIndex(columnName));
+		}
+
+		// Returns the contiguous values of a column holding only one type of data, or an empty
+		// span if the column holds any other type or is dictionary encoded.
+		template <typename T>
+		Span<T> GetColumn(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			const Column & column = m_columns[columnIndex];
+			if (column.type != Column::template TypeOf<T>() || column.IsEncoded())
+				return Span<T>();
+			const auto & values = column.template Values<T>();
+			return Span<T>(values.data(), values.size());
+		}
+		template <typename T>
+		Span<T> GetColumn(const Name & columnName) const
+		{
+			return GetColumn<T>(GetColumnIndex(columnName));
+		}
+
+		static constexpr uint32_t NoCode = UINT32_MAX;
+
+		// Returns the code of each row of a dictionary encoded string column, or an empty span if
+		// the column isn't encoded.  Each code is an index into the column's dictionary, so rows
+		// with equal values have equal codes.
+		Span<uint32_t> GetCodes(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			const auto & codes = m_columns[columnIndex].codes;
+			return Span<uint32_t>(codes.data(), codes.size());
+		}
+		Span<uint32_t> GetCodes(const Name & columnName) const
+		{
+			return GetCodes(GetColumnIndex(columnName));
+		}
+
+		// Returns the distinct values of a dictionary encoded string column, in order of their
+		// first appearance, or an empty span if the column isn't encoded.
+		Span<CellString> GetDictionary(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			const Column & column = m_columns[columnIndex];
+			if (!column.IsEncoded())
+				return Span<CellString>();
+			return Span<CellString>(column.strings.data(), column.strings.size());
+		}
+		Span<CellString> GetDictionary(const Name & columnName) const
+		{
+			return GetDictionary(GetColumnIndex(columnName));
+		}
+
+		// Returns the code of a value in a dictionary encoded string column, or NoCode if the
+		// value doesn't appear in the column or the column isn't encoded.
+		uint32_t FindCode(size_t columnIndex, const Name & value) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			const size_t code = m_columns[columnIndex].dictionary.Find(value.GetName(), value.GetHash());
+			return code == StringIndexMap::NotFound ? NoCode : static_cast<uint32_t>(code);
+		}
+		uint32_t FindCode(const Name & columnName, const Name & value) const
+		{
+			return FindCode(GetColumnIndex(columnName), value);
+		}
+
+		// Column aggregates over the integer and double cells of a column.  String cells are
+		// ignored, so Count() returns the number of numeric cells.  Sum() returns zero, and Min(),
+		// Max(), and Mean() return NaN, if a column has no numeric cells.
+		size_t Count(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].CountNumbers();
+		}
+		size_t Count(const Name & columnName) const
+		{
+			return Count(GetColumnIndex(columnName));
+		}
+		double Sum(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].Sum();
+		}
+		double Sum(const Name & columnName) const
+		{
+			return Sum(GetColumnIndex(columnName));
+		}
+		double Min(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].template Limit<false>();
+		}
+		double Min(const Name & columnName) const
+		{
+			return Min(GetColumnIndex(columnName));
+		}
+		double Max(size_t columnIndex) const
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			return m_columns[columnIndex].template Limit<true>();
+		}
+		double Max(const Name & columnName) const
+		{
+			return Max(GetColumnIndex(columnName));
+		}
+		double Mean(size_t columnIndex) const
+		{
+			const size_t count = Count(columnIndex);
+			return count ? Sum(columnIndex) / static_cast<double>(count) : std::numeric_limits<double>::quiet_NaN();
+		}
+		double Mean(const Name & columnName) const
+		{
+			return Mean(GetColumnIndex(columnName));
+		}
+
+		// Builds a hash index over a column's values, so FindRows() can find the rows holding a
+		// value without scanning the column.  Indexes aren't stored in snapshots.
+		void BuildIndex(size_t columnIndex)
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			// A copied table shares its arena with the original, so indexes are built on the heap
+			Arena::Scope scope(nullptr);
+			if (m_hashIndexes.size() < GetNumColumns())
+				m_hashIndexes.resize(GetNumColumns());
+			m_hashIndexes[columnIndex].Build(m_columns[columnIndex]);
+		}
+		void BuildIndex(const Name & columnName)
+		{
+			BuildIndex(GetColumnIndex(columnName));
+		}
+		bool HasIndex(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			return columnIndex < m_hashIndexes.size() && !m_hashIndexes[columnIndex].slots.empty();
+		}
+		bool HasIndex(const Name & columnName) const
+		{
+			return HasIndex(GetColumnIndex(columnName));
+		}
+
+		// Returns the indices of all rows holding a value in an indexed column, in row order.
+		// Values may be integers, doubles, or strings, and only match cells of the same type.
+		template<typename T>
+		Span<uint32_t> FindRows(size_t columnIndex, const T & value) const
+		{
+			assert(!m_error);
+			// If this assert hits, BuildIndex() hasn't been called for the column
+			assert(HasIndex(columnIndex));
+			if (!HasIndex(columnIndex))
+				return Span<uint32_t>();
+			CellKey key;
+			if constexpr (std::is_integral_v<T>)
+			{
+				key.type = ColumnType::Integer;
+				key.intValue = static_cast<int64_t>(value);
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				key.type = ColumnType::Double;
+				key.doubleValue = static_cast<double>(value);
+			}
+			else if constexpr (std::is_same_v<T, Name>)
+			{
+				key.type = ColumnType::String;
+				key.text = value.GetName();
+			}
+			else
+			{
+				key.type = ColumnType::String;
+				key.text = std::string_view(value);
+			}
+			return m_hashIndexes[columnIndex].Find(m_columns[columnIndex], key);
+		}
+		template<typename T>
+		Span<uint32_t> FindRows(const Name & columnName, const T & value) const
+		{
+			return FindRows(GetColumnIndex(columnName), value);
+		}
+
+		// Builds a range index over a column's numeric cells, so Range() can find the rows with
+		// values in a range without scanning the column.  Large columns are sorted using up to
+		// the requested number of threads, or all hardware threads if zero.  Indexes aren't
+		// stored in snapshots.
+		void BuildRangeIndex(size_t columnIndex, size_t threads = 1)
+		{
+			assert(!m_error);
+			assert(columnIndex < GetNumColumns());
+			// A copied table shares its arena with the original, so indexes are built on the heap
+			Arena::Scope scope(nullptr);
+			if (m_rangeIndexes.size() < GetNumColumns())
+				m_rangeIndexes.resize(GetNumColumns());
+			m_rangeIndexes[columnIndex].Build(m_columns[columnIndex], threads);
+		}
+		void BuildRangeIndex(const Name & columnName, size_t threads = 1)
+		{
+			BuildRangeIndex(GetColumnIndex(columnName), threads);
+		}
+		bool HasRangeIndex(size_t columnIndex) const
+		{
+			assert(columnIndex < GetNumColumns());
+			return columnIndex < m_rangeIndexes.size() && m_rangeIndexes[columnIndex].built;
+		}
+		bool HasRangeIndex(const Name & columnName) const
+		{
+			return HasRangeIndex(GetColumnIndex(columnName));
+		}
+
+		// Returns the indices of all rows of a range indexed column with numeric values from lo
+		// to hi inclusive, ordered by value and then by row.  String cells are never included.
+		Span<uint32_t> Range(size_t columnIndex, double lo, double hi) const
+		{
+			assert(!m_error);
+			// If this assert hits, BuildRangeIndex() hasn't been called for the column
+			assert(HasRangeIndex(columnIndex));
+			if (!HasRangeIndex(columnIndex))
+				return Span<uint32_t>();
+			return m_rangeIndexes[columnIndex].Find(m_columns[columnIndex], lo, hi);
+		}
+		Span<uint32_t> Range(const Name & columnName, double lo, double hi) const
+		{
+			return Range(GetColumnIndex(columnName), lo, hi);
+		}
+
+		// Grouping is the rows of a table grouped by the values of a key column, which are
+		// aggregated into a new table.  The source table must outlive the grouping.
+		class Grouping
+		{
+		public:
+			Grouping(const Table & table, size_t keyColumnIndex, size_t threads) :
+				m_table(&table), m_keyColumnIndex(keyColumnIndex), m_threads(threads)
+			{
+			}
+
+			// Returns a table with a row for each distinct key, in order of each key's first row,
+			// named by the key's text.  The first column holds the key, followed by a column for
+			// each aggregation.  Sums, minimums, and maximums of integer columns are integers,
+			// and other aggregates of groups without numeric cells are NaN.  If a column isn't
+			// found, or keys of different types have the same text, the table reports an error.
+			Table Aggregate(const std::vector<Aggregation> & aggregations) const
+			{
+				return m_table->AggregateGroups(m_keyColumnIndex, aggregations, m_threads);
+			}
+
+		private:
+			const Table * m_table;
+			size_t m_keyColumnIndex;
+			size_t m_threads;
+		};
+
+		// Groups rows by the values of a key column.  Large tables are aggregated using up to the
+		// requested number of threads, or all hardware threads if zero, each accumulating
+		// partial aggregates for a range of rows, which are then merged.
+		Grouping GroupBy(size_t keyColumnIndex, size_t threads = 1) const
+		{
+			assert(!m_error);
+			assert(keyColumnIndex < GetNumColumns());
+			return Grouping(*this, keyColumnIndex, threads);
+		}
+		Grouping GroupBy(const Name & keyColumnName, size_t threads = 1) const
+		{
+			return GroupBy(GetColumnIndex(keyColumnName), threads);
+		}
+
+	private:
+
+		template<typename, typename>
+		friend class TableSet;
+		template<typename, typename>
+		friend class JoinView;
+
+		Table() = default;
+
+		static Table FromMappedFile(std::shared_ptr<const Detail::MappedFile> file, const Options & options)
+		{
+			Table table;
+			table.m_error = !*file || !table.Read(file->GetText(), options);
+			if constexpr (!OwnsStrings)
+				table.m_file = std::move(file);
+			return table;
+		}
+
+		// MixedCell is a 16 byte cell of a mixed column, holding either a number or the index of
+		// a string stored in the column's strings array.
+		struct MixedCell
+		{
+			static MixedCell Integer(int64_t value) { MixedCell cell; cell.intValue = value; cell.type = ColumnType::Integer; return cell; }
+			static MixedCell Double(double value) { MixedCell cell; cell.doubleValue = value; cell.type = ColumnType::Double; return cell; }
+			static MixedCell String(size_t index) { MixedCell cell; cell.stringIndex = index; cell.type = ColumnType::String; return cell; }
+
+			union
+			{
+				int64_t intValue;
+				double doubleValue;
+				size_t stringIndex;
+			};
+			ColumnType type;
+		};
+		static_assert(sizeof(MixedCell) <= 16, "Mixed cells should be no larger than 16 bytes");
+		static constexpr bool MixedCellMatchesSnapshot = sizeof(MixedCell) == sizeof(Detail::SnapshotMixedCell) &&
+			sizeof(size_t) == sizeof(uint64_t) && sizeof(ColumnType) == sizeof(uint32_t) && offsetof(MixedCell, type) == offsetof(Detail::SnapshotMixedCell, type);
+
+		// CellKey is the value of a cell used as a key in an index, with strings viewed rather
+		// than copied.  Keys of different types never compare equal.
+		struct CellKey
+		{
+			uint64_t Hash() const
+			{
+				switch (type)
+				{
+					case ColumnType::Integer: return Detail::MixHash(static_cast<uint64_t>(intValue));
+					case ColumnType::Double:
+					{
+						// Zero and negative zero are equal, so they must hash equally
+						uint64_t bits = 0;
+						if (doubleValue != 0.0)
+							std::memcpy(&bits, &doubleValue, sizeof(bits));
+						return Detail::MixHash(bits ^ 0x9e3779b97f4a7c15ull);
+					}
+					default: return Detail::HashString(text);
+				}
+			}
+
+			bool operator == (const CellKey & other) const
+			{
+				if (type != other.type)
+					return false;
+				switch (type)
+				{
+					case ColumnType::Integer: return intValue == other.intValue;
+					case ColumnType::Double: return doubleValue == other.doubleValue;
+					default: return text == other.text;
+				}
+			}
+
+			ColumnType type = ColumnType::Empty;
+			int64_t intValue = 0;
+			double doubleValue = 0.0;
+			std::string_view text;
+		};
+
+		// Column stores its cells in a contiguous array of the column's type.  If cells of a
+		// different type are added, the column is converted to mixed storage.  A dictionary
+		// encoded string column stores each distinct value once in strings, along with the index
+		// of each row's value in codes.
+		struct Column
+		{
+			template<typename T>
+			static constexpr ColumnType TypeOf()
+			{
+				if constexpr (std::is_same_v<T, int64_t>)
+					return ColumnType::Integer;
+				else if constexpr (std::is_same_v<T, double>)
+					return ColumnType::Double;
+				else
+				{
+					static_assert(std::is_same_v<T, CellString>, "Invalid table data type");
+					return ColumnType::String;
+				}
+			}
+
+			static ColumnType TypeOf(const TableData & data)
+			{
+				switch (data.index())
+				{
+					case IntType: return ColumnType::Integer;
+					case DoubleType: return ColumnType::Double;
+					default: return ColumnType::String;
+				}
+			}
+
+			template<typename T>
+			auto & Values()
+			{
+				if constexpr (std::is_same_v<T, int64_t>)
+					return ints;
+				else if constexpr (std::is_same_v<T, double>)
+					return doubles;
+				else
+					return strings;
+			}
+
+			template<typename T>
+			const auto & Values() const
+			{
+				return const_cast<Column *>(this)->template Values<T>();
+			}
+
+			size_t Size() const
+			{
+				switch (type)
+				{
+					case ColumnType::Integer: return ints.size();
+					case ColumnType::Double: return doubles.size();
+					case ColumnType::String: return IsEncoded() ? codes.size() : strings.size();
+					case ColumnType::Mixed: return mixed.size();
+					default: return 0;
+				}
+			}
+
+			bool IsEncoded() const { return !codes.empty(); }
+
+			CellKey GetKey(size_t row) const
+			{
+				assert(row < Size());
+				CellKey key;
+				key.type = type == ColumnType::Mixed ? mixed[row].type : type;
+				switch (type)
+				{
+					case ColumnType::Integer: key.intValue = ints[row]; break;
+					case ColumnType::Double: key.doubleValue = doubles[row]; break;
+					case ColumnType::String: key.text = strings[IsEncoded() ? codes[row] : row]; break;
+					default:
+						if (key.type == ColumnType::Integer)
+							key.intValue = mixed[row].intValue;
+						else if (key.type == ColumnType::Double)
+							key.doubleValue = mixed[row].doubleValue;
+						else
+							key.text = strings[mixed[row].stringIndex];
+						break;
+				}
+				return key;
+			}
+
+			// Aggregates keep integers and doubles apart, so integer and double columns each use
+			// their own kernel over contiguous values.  Cells of mixed columns are selected by
+			// their type tag, and string cells are ignored.
+			size_t CountNumbers() const
+			{
+				switch (type)
+				{
+					case ColumnType::Integer: return ints.size();
+					case ColumnType::Double: return doubles.size();
+					case ColumnType::Mixed:
+						return std::count_if(mixed.begin(), mixed.end(), [](const MixedCell & cell) { return cell.type != ColumnType::String; });
+					default: return 0;
+				}
+			}
+
+			double Sum() const
+			{
+				switch (type)
+				{
+					case ColumnType::Integer: return Detail::SumInts(ints.data(), ints.size());
+					case ColumnType::Double: return Detail::SumDoubles(doubles.data(), doubles.size());
+					case ColumnType::Mixed:
+					{
+						// Integers are summed by their 32-bit halves, which can't overflow
+						int64_t intHigh = 0;
+						uint64_t intLow = 0;
+						double doubleSum = 0.0;
+						for (const MixedCell & cell : mixed)
+						{
+							const int64_t intValue = cell.type == ColumnType::Integer ? cell.intValue : 0;
+							intHigh += intValue >> 32;
+							intLow += static_cast<uint64_t>(intValue) & 0xffffffff;
+							doubleSum += cell.type == ColumnType::Double ? cell.doubleValue : 0.0;
+						}
+						return static_cast<double>(intHigh) * 4294967296.0 + static_cast<double>(intLow) + doubleSum;
+					}
+					default: return 0.0;
+				}
+			}
+
+			template<bool IsMax>
+			double Limit() const
+			{
+				const double none = std::numeric_limits<double>::quiet_NaN();
+				switch (type)
+				{
+					case ColumnType::Integer:
+						return ints.empty() ? none : static_cast<double>(Detail::LimitInts<IsMax>(ints.data(), ints.size()));
+					case ColumnType::Double:
+						return doubles.empty() ? none : Detail::LimitDoubles<IsMax>(doubles.data(), doubles.size());
+					case ColumnType::Mixed:
+					{
+						double limit = none;
+						for (const MixedCell & cell : mixed)
+						{
+							if (cell.type == ColumnType::String)
+								continue;
+							const double value = cell.type == ColumnType::Integer ? static_cast<double>(cell.intValue) : cell.doubleValue;
+							if (std::isnan(limit) || (IsMax ? value > limit : value < limit))
+								limit = value;
+						}
+						return limit;
+					}
+					default: return none;
+				}
+			}
+
+			TableData GetData(size_t row) const
+			{
+				assert(row < Size());
+				switch (type)
+				{
+					case ColumnType::Integer: return ints[row];
+					case ColumnType::Double: return doubles[row];
+					case ColumnType::String: return strings[IsEncoded() ? codes[row] : row];
+					default: break;
+				}
+				const MixedCell & cell = mixed[row];
+				switch (cell.type)
+				{
+					case ColumnType::Integer: return cell.intValue;
+					case ColumnType::Double: return cell.doubleValue;
+					default: return strings[cell.stringIndex];
+				}
+			}
+
+			template<typename T>
+			const T & Get(size_t row) const
+			{
+				assert(row < Size());
+				if constexpr (std::is_same_v<T, CellString>)
+				{
+					if (type == ColumnType::String && IsEncoded())
+						return strings[codes[row]];
+				}
+				if (type == TypeOf<T>())
+					return Values<T>()[row];
+				if (type == ColumnType::Mixed && mixed[row].type == TypeOf<T>())
+				{
+					if constexpr (std::is_same_v<T, int64_t>)
+						return mixed[row].intValue;
+					else if constexpr (std::is_same_v<T, double>)
+						return mixed[row].doubleValue;
+					else
+						return strings[mixed[row].stringIndex];
+				}
+
+				// The cell holds a different type, so report the error the same way std::get does
+				static const TableData mismatch = std::is_same_v<T, int64_t> ? TableData(0.0) : TableData(int64_t(0));
+				return std::get<T>(mismatch);
+			}
+
+			void Append(TableData && data)
+			{
+				if (type == ColumnType::Empty)
+				{
+					type = TypeOf(data);
+					Reserve(expectedSize);
+				}
+				else if (type != ColumnType::Mixed && type != TypeOf(data))
+					ConvertToMixed();
+				switch (type)
+				{
+					case ColumnType::Integer: ints.push_back(std::get<int64_t>(data)); break;
+					case ColumnType::Double: doubles.push_back(std::get<double>(data)); break;
+					case ColumnType::String: strings.push_back(std::move(std::get<CellString>(data))); break;
+					default: AppendMixed(std::move(data)); break;
+				}
+			}
+
+			void AppendMixed(TableData && data)
+			{
+				switch (data.index())
+				{
+					case IntType: mixed.push_back(MixedCell::Integer(std::get<int64_t>(data))); break;
+					case DoubleType: mixed.push_back(MixedCell::Double(std::get<double>(data))); break;
+					default:
+						mixed.push_back(MixedCell::String(strings.size()));
+						strings.push_back(std::move(std::get<CellString>(data)));
+						break;
+				}
+			}
+
+			void Append(Column && other)
+			{
+				if (other.type == ColumnType::Empty)
+					return;
+				if (type == ColumnType::Empty)
+				{
+					*this = std::move(other);
+					return;
+				}
+				if (type != other.type)
+				{
+					ConvertToMixed();
+					other.ConvertToMixed();
+				}
+				switch (type)
+				{
+					case ColumnType::Integer: AppendValues(ints.Values(), other.ints.Values()); break;
+					case ColumnType::Double: AppendValues(doubles.Values(), other.doubles.Values()); break;
+					case ColumnType::String: AppendValues(strings, other.strings); break;
+					default:
+						// The other column's strings follow this column's strings
+						mixed.reserve(mixed.size() + other.mixed.size());
+						for (const MixedCell & cell : other.mixed)
+							mixed.push_back(cell.type == ColumnType::String ? MixedCell::String(cell.stringIndex + strings.size()) : cell);
+						AppendValues(strings, other.strings);
+						break;
+				}
+				other = Column();
+			}
+
+			void Reserve(size_t size)
+			{
+				switch (type)
+				{
+					case ColumnType::Integer: ints.reserve(size); break;
+					case ColumnType::Double: doubles.reserve(size); break;
+					case ColumnType::String: strings.reserve(size); break;
+					case ColumnType::Mixed: mixed.reserve(size); break;
+					default: break;
+				}
+			}
+
+			template<typename T>
+			static void AppendValues(Vector<T> & values, Vector<T> & other)
+			{
+				values.insert(values.end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+			}
+
+			void ConvertToMixed()
+			{
+				if (type == ColumnType::Mixed)
+					return;
+				// Strings stay in place, so each string cell refers to its own row
+				assert(!IsEncoded());
+				mixed.reserve(std::max(Size(), expectedSize));
+				switch (type)
+				{
+					case ColumnType::Integer: for (int64_t value : ints) mixed.push_back(MixedCell::Integer(value)); break;
+					case ColumnType::Double: for (double value : doubles) mixed.push_back(MixedCell::Double(value)); break;
+					case ColumnType::String: for (size_t row = 0; row < strings.size(); ++row) mixed.push_back(MixedCell::String(row)); break;
+					default: break;
+				}
+				ints = Vector<int64_t>();
+				doubles = Vector<double>();
+				type = ColumnType::Mixed;
+			}
+
+			// Dictionary encodes a string column if at most the given fraction of its values are
+			// distinct.  Distinct values are found with an open addressing table, and encoding is
+			// abandoned as soon as too many are found.  Returns false if the dictionary couldn't be
+			// indexed.
+			bool Encode(double maxRatio)
+			{
+				if (type != ColumnType::String || IsEncoded() || strings.size() < Options::MinDictionaryRows)
+					return true;
+				const size_t maxDistinct = static_cast<size_t>(static_cast<double>(strings.size()) * maxRatio);
+
+				// Temporary arrays are allocated from the heap, not an arena, so nothing is left in
+				// the arena if encoding is abandoned
+				Arena * arena = Arena::GetCurrent();
+				Arena::Scope scope(nullptr);
+				const uint32_t EmptySlot = UINT32_MAX;
+				size_t slotCount = 16;
+				while (slotCount < maxDistinct * 2)
+					slotCount *= 2;
+				Vector<uint32_t> slots(slotCount, EmptySlot);
+				Vector<size_t> firstRows;
+				Vector<uint32_t> rowCodes(strings.size());
+				for (size_t row = 0; row < strings.size(); ++row)
+				{
+					const std::string_view str = strings[row];
+					size_t slot = Detail::HashString(str) & (slotCount - 1);
+					while (slots[slot] != EmptySlot && std::string_view(strings[firstRows[slots[slot]]]) != str)
+						slot = (slot + 1) & (slotCount - 1);
+					if (slots[slot] == EmptySlot)
+					{
+						if (firstRows.size() == maxDistinct)
+							return true;
+						slots[slot] = static_cast<uint32_t>(firstRows.size());
+						firstRows.push_back(row);
+					}
+					rowCodes[row] = slots[slot];
+				}
+
+				// Distinct values are moved to the front of the existing strings, in order of first
+				// appearance, rather than into a new array.  Codes are copied into the arena, if the
+				// column uses one.
+				for (size_t code = 0; code < firstRows.size(); ++code)
+				{
+					if (firstRows[code] != code)
+						strings[code] = std::move(strings[firstRows[code]]);
+				}
+				strings.resize(firstRows.size());
+				if constexpr (UsesArena)
+				{
+					Arena::Scope arenaScope(arena);
+					codes = Vector<uint32_t>(rowCodes.begin(), rowCodes.end());
+				}
+				else
+					codes = std::move(rowCodes);
+				return dictionary.Build(Vector<std::string_view>(strings.begin(), strings.end()));
+			}
+
+			// Numeric cells, mixed cells, and codes may be viewed in place in a snapshot
+			ColumnType type = ColumnType::Empty;
+			Detail::Array<int64_t, Alloc> ints;
+			Detail::Array<double, Alloc> doubles;
+			Vector<CellString> strings;
+			Detail::Array<MixedCell, Alloc> mixed;
+			Detail::Array<uint32_t, Alloc> codes;
+			StringIndexMap dictionary;
+			// Number of rows expected, which is reserved once the column's type is known
+			size_t expectedSize = 0;
+		};
+		using VectorColumn = Vector<Column>;
+
+		// HashIndex finds the rows of a column holding a value.  Rows are grouped by value in a
+		// single array, in row order within each group, and an open addressing table refers to
+		// each group.  A group's first row is used to compare its value with a key.
+		struct HashIndex
+		{
+			struct Slot
+			{
+				uint64_t hash;
+				uint32_t start;
+				uint32_t count;
+			};
+
+			void Build(const Column & column)
+			{
+				const size_t rowCount = column.Size();
+				assert(rowCount < UINT32_MAX);
+				size_t slotCount = 16;
+				while (slotCount < rowCount * 2)
+					slotCount *= 2;
+				slots.assign(slotCount, Slot{ 0, 0, 0 });
+
+				// Count the rows holding each value, remembering each row's slot
+				Vector<uint32_t> rowSlots(rowCount);
+				for (size_t row = 0; row < rowCount; ++row)
+				{
+					const CellKey key = column.GetKey(row);
+					const uint64_t hash = key.Hash();
+					size_t slot = hash & (slotCount - 1);
+					while (slots[slot].count != 0 && (slots[slot].hash != hash || !(column.GetKey(slots[slot].start) == key)))
+						slot = (slot + 1) & (slotCount - 1);
+					if (slots[slot].count++ == 0)
+					{
+						slots[slot].hash = hash;
+						slots[slot].start = static_cast<uint32_t>(row);
+					}
+					rowSlots[row] = static_cast<uint32_t>(slot);
+				}
+
+				// Group rows by value, with each slot's start then referring to its group
+				uint32_t start = 0;
+				for (Slot & slot : slots)
+				{
+					if (slot.count == 0)
+						continue;
+					slot.start = start;
+					start += slot.count;
+				}
+				rows.resize(rowCount);
+				Vector<uint32_t> next(slotCount);
+				for (size_t slot = 0; slot < slotCount; ++slot)
+					next[slot] = slots[slot].start;
+				for (size_t row = 0; row < rowCount; ++row)
+					rows[next[rowSlots[row]]++] = static_cast<uint32_t>(row);
+			}
+
+			Span<uint32_t> Find(const Column & column, const CellKey & key) const
+			{
+				if (slots.empty())
+					return Span<uint32_t>();
+				const uint64_t hash = key.Hash();
+				const size_t mask = slots.size() - 1;
+				for (size_t slot = hash & mask; slots[slot].count != 0; slot = (slot + 1) & mask)
+				{
+					const Slot & entry = slots[slot];
+					if (entry.hash == hash && column.GetKey(rows[entry.start]) == key)
+						return Span<uint32_t>(rows.data() + entry.start, entry.count);
+				}
+				return Span<uint32_t>();
+			}
+
+			Vector<Slot> slots;
+			Vector<uint32_t> rows;
+		};
+
+		// RangeIndex holds the rows of a column's numeric cells sorted by value, with equal values
+		// in row order, so the rows with values in a range are contiguous and found with a
+		// binary search.  NaN values are sorted after every other value, and never in a range.
+		struct RangeIndex
+		{
+			static const size_t MinParallelSortSize = 16 * 1024;
+
+			void Build(const Column & column, size_t threads)
+			{
+				rows.clear();
+				const size_t rowCount = column.Size();
+				assert(rowCount < UINT32_MAX);
+				if (column.type == ColumnType::Integer || column.type == ColumnType::Double)
+				{
+					rows.resize(rowCount);
+					for (size_t row = 0; row < rowCount; ++row)
+						rows[row] = static_cast<uint32_t>(row);
+				}
+				else if (column.type == ColumnType::Mixed)
+				{
+					for (size_t row = 0; row < rowCount; ++row)
+					{
+						if (column.mixed[row].type != ColumnType::String)
+							rows.push_back(static_cast<uint32_t>(row));
+					}
+				}
+				if (column.type == ColumnType::Integer)
+					Sort([&](uint32_t a, uint32_t b) { return column.ints[a] < column.ints[b]; }, threads);
+				else
+				{
+					Sort([&](uint32_t a, uint32_t b)
+					{
+						const double valueA = GetValue(column, a);
+						const double valueB = GetValue(column, b);
+						return valueA < valueB || (std::isnan(valueB) && !std::isnan(valueA));
+					}, threads);
+				}
+				valueCount = rows.size();
+				if (column.type != ColumnType::Integer)
+				{
+					const auto nanStart = std::partition_point(rows.begin(), rows.end(), [&](uint32_t row) { return !std::isnan(GetValue(column, row)); });
+					valueCount = static_cast<size_t>(nanStart - rows.begin());
+				}
+				built = true;
+			}
+
+			Span<uint32_t> Find(const Column & column, double lo, double hi) const
+			{
+				if (std::isnan(lo) || std::isnan(hi))
+					return Span<uint32_t>();
+				const auto end = rows.begin() + valueCount;
+				const auto first = std::lower_bound(rows.begin(), end, lo, [&](uint32_t row, double value) { return GetValue(column, row) < value; });
+				const auto last = std::upper_bound(first, end, hi, [&](double value, uint32_t row) { return value < GetValue(column, row); });
+				if (first >= last)
+					return Span<uint32_t>();
+				return Span<uint32_t>(&*first, static_cast<size_t>(last - first));
+			}
+
+			static double GetValue(const Column & column, uint32_t row)
+			{
+				switch (column.type)
+				{
+					case ColumnType::Integer: return static_cast<double>(column.ints[row]);
+					case ColumnType::Double: return column.doubles[row];
+					default:
+					{
+						const MixedCell & cell = column.mixed[row];
+						return cell.type == ColumnType::Integer ? static_cast<double>(cell.intValue) : cell.doubleValue;
+					}
+				}
+			}
+
+			// Sorts the rows stably.  Large indexes are split into a run per thread, which are
+			// sorted in parallel and then merged in pairs, with each level's merges in parallel.
+			template<typename Less>
+			void Sort(Less less, size_t threads)
+			{
+				const size_t count = rows.size();
+				const size_t runCount = std::min(Detail::GetThreadCount(threads), count / MinParallelSortSize);
+				if (runCount <= 1)
+				{
+					std::stable_sort(rows.begin(), rows.end(), less);
+					return;
+				}
+				Vector<size_t> bounds(runCount + 1);
+				for (size_t run = 0; run <= runCount; ++run)
+					bounds[run] = count * run / runCount;
+				Detail::ParallelFor(runCount, threads, [&](size_t run)
+				{
+					std::stable_sort(rows.begin() + bounds[run], rows.begin() + bounds[run + 1], less);
+				});
+				Vector<uint32_t> merged(count);
+				for (size_t width = 1; width < runCount; width *= 2)
+				{
+					const size_t pairCount = (runCount + width * 2 - 1) / (width * 2);
+					Detail::ParallelFor(pairCount, threads, [&](size_t pair)
+					{
+						const size_t first = bounds[pair * width * 2];
+						const size_t middle = bounds[std::min(pair * width * 2 + width, runCount)];
+						const size_t last = bounds[std::min(pair * width * 2 + width * 2, runCount)];
+						std::merge(rows.begin() + first, rows.begin() + middle, rows.begin() + middle, rows.begin() + last, merged.begin() + first, less);
+					});
+					rows.swap(merged);
+				}
+			}
+
+			Vector<uint32_t> rows;
+			size_t valueCount = 0;
+			bool built = false;
+		};
+
+		// GroupAggregator accumulates the numeric cells of some columns for each distinct value of
+		// a key column, using an open addressing table of groups.  Groups are kept in order of
+		// their first row, and partial aggregates of consecutive ranges of rows can be merged
+		// in order.
+		struct GroupAggregator
+		{
+			static const size_t MinParallelGroupSize = 16 * 1024;
+
+			// Integers and doubles are accumulated separately, so integer columns stay exact
+			struct Accumulator
+			{
+				void Add(const CellKey & value)
+				{
+					if (value.type == ColumnType::Integer)
+					{
+						intSum += static_cast<uint64_t>(value.intValue);
+						intMin = std::min(intMin, value.intValue);
+						intMax = std::max(intMax, value.intValue);
+						++intCount;
+					}
+					else if (value.type == ColumnType::Double)
+					{
+						doubleSum += value.doubleValue;
+						doubleMin = std::min(doubleMin, value.doubleValue);
+						doubleMax = std::max(doubleMax, value.doubleValue);
+						++doubleCount;
+					}
+				}
+
+				void Merge(const Accumulator & other)
+				{
+					intSum += other.intSum;
+					intMin = std::min(intMin, other.intMin);
+					intMax = std::max(intMax, other.intMax);
+					intCount += other.intCount;
+					doubleSum += other.doubleSum;
+					doubleMin = std::min(doubleMin, other.doubleMin);
+					doubleMax = std::max(doubleMax, other.doubleMax);
+					doubleCount += other.doubleCount;
+				}
+
+				uint64_t intSum = 0;
+				int64_t intMin = INT64_MAX;
+				int64_t intMax = INT64_MIN;
+				size_t intCount = 0;
+				double doubleSum = 0.0;
+				double doubleMin = std::numeric_limits<double>::infinity();
+				double doubleMax = -std::numeric_limits<double>::infinity();
+				size_t doubleCount = 0;
+			};
+
+			struct Slot
+			{
+				uint64_t hash;
+				uint32_t group;
+			};
+
+			GroupAggregator(const Column & keyColumn, const Vector<const Column *> & columns) :
+				keyColumn(keyColumn), columns(columns)
+			{
+			}
+
+			void AddRows(size_t begin, size_t end)
+			{
+				for (size_t row = begin; row < end; ++row)
+				{
+					const CellKey key = keyColumn.GetKey(row);
+					const size_t group = FindGroup(key, key.Hash(), static_cast<uint32_t>(row));
+					++rowCounts[group];
+					Accumulator * accumulator = accumulators.data() + group * columns.size();
+					for (size_t column = 0; column < columns.size(); ++column)
+					{
+						if (columns[column])
+							accumulator[column].Add(columns[column]->GetKey(row));
+					}
+				}
+			}
+
+			void Merge(const GroupAggregator & other)
+			{
+				for (size_t otherGroup = 0; otherGroup < other.firstRows.size(); ++otherGroup)
+				{
+					const uint32_t row = other.firstRows[otherGroup];
+					const size_t group = FindGroup(keyColumn.GetKey(row), other.hashes[otherGroup], row);
+					rowCounts[group] += other.rowCounts[otherGroup];
+					for (size_t column = 0; column < columns.size(); ++column)
+						accumulators[group * columns.size() + column].Merge(other.accumulators[otherGroup * columns.size() + column]);
+				}
+			}
+
+			// Returns the group of a key, adding a group starting at the given row if it's new
+			size_t FindGroup(const CellKey & key, uint64_t hash, uint32_t row)
+			{
+				if ((firstRows.size() + 1) * 2 > slots.size())
+					Grow();
+				const size_t mask = slots.size() - 1;
+				size_t slot = hash & mask;
+				for (; slots[slot].group != EmptyGroup; slot = (slot + 1) & mask)
+				{
+					const uint32_t group = slots[slot].group;
+					if (slots[slot].hash == hash && keyColumn.GetKey(firstRows[group]) == key)
+						return group;
+				}
+				slots[slot] = { hash, static_cast<uint32_t>(firstRows.size()) };
+				firstRows.push_back(row);
+				hashes.push_back(hash);
+				rowCounts.push_back(0);
+				accumulators.resize(accumulators.size() + columns.size());
+				return firstRows.size() - 1;
+			}
+
+			void Grow()
+			{
+				const size_t slotCount = std::max<size_t>(slots.size() * 2, 16);
+				slots.assign(slotCount, Slot{ 0, EmptyGroup });
+				for (size_t group = 0; group < firstRows.size(); ++group)
+				{
+					size_t slot = hashes[group] & (slotCount - 1);
+					while (slots[slot].group != EmptyGroup)
+						slot = (slot + 1) & (slotCount - 1);
+					slots[slot] = { hashes[group], static_cast<uint32_t>(group) };
+				}
+			}
+
+			static const uint32_t EmptyGroup = UINT32_MAX;
+
+			const Column & keyColumn;
+			// Column accumulated for each aggregate, or nullptr if it only counts rows
+			const Vector<const Column *> & columns;
+			Vector<Slot> slots;
+			Vector<uint32_t> firstRows;
+			Vector<uint64_t> hashes;
+			Vector<size_t> rowCounts;
+			Vector<Accumulator> accumulators;
+		};
+
+		String Unescape(std::string_view text) const
+		{
+			String str;
+			Detail::AppendUnescaped(str, text);
+			return str;
+		}
+
+		String ToString(const Detail::Cell & cell) const
+		{
+			return cell.escaped ? Unescape(cell.text) : String(cell.text);
+		}
+
+		CellString ToCellString(const Detail::Cell & cell, StringPool & pool) const
+		{
+			if constexpr (OwnsStrings)
+			{
+				(void)pool;
+				return ToString(cell);
+			}
+			else
+			{
+				// Unescaped cells can refer to the source text directly, but escaped cells must
+				// be stored in the pool.
+				if (!cell.escaped)
+					return cell.text;
+				pool.push_back(Unescape(cell.text));
+				return pool.back();
+			}
+		}
+
+		bool ParseNumber(const Detail::Cell & cell, Detail::Format format, TableData & data) const
+		{
+			int64_t intValue = 0;
+			double doubleValue = 0.0;
+			switch (Detail::ParseNumber(cell, format, intValue, doubleValue))
+			{
+				case Detail::NumberType::Integer: data = intValue; return true;
+				case Detail::NumberType::Double: data = doubleValue; return true;
+				default: return false;
+			}
+		}
+
+		// Parsing state shared by every row read from the text
+		struct ReadContext
+		{
+			static const size_t Skipped = SIZE_MAX;
+
+			char delimiter = 0;
+			Detail::Format format = Detail::Format::International;
+			// Table column index for each column in the text, or Skipped if it isn't loaded
+			Vector<size_t> columns;
+			// Row filter, along with the text column index of each filter column
+			const std::function<bool(const RowView &)> * filter = nullptr;
+			Vector<size_t> filterColumns;
+			size_t lastFilterColumn = 0;
+			size_t filterNameIndex = Skipped;
+		};
+
+		// Cells held while a row's filter columns are read, reused from row to row
+		struct FilterState
+		{
+			Vector<Detail::Cell> pending;
+			Vector<Detail::Cell> cells;
+			String unescaped;
+		};
+
+		bool ReadHeader(Detail::Scanner & scanner, size_t & pos, const Options & options, ReadContext & context)
+		{
+			std::string_view text = scanner.GetText();
+			bool malformed = false;
+			StringPool names;
+			Vector<std::string_view> keys;
+			while (pos < text.size())
+			{
+				names.push_back(ToString(Detail::ParseCell(scanner, pos, malformed)));
+				if (keys.empty() || options.columns.empty() ||
+					std::find(options.columns.begin(), options.columns.end(), names.back()) != options.columns.end())
+					keys.push_back(names.back());
+				if (pos == text.size() || Detail::IsLineEnd(text[pos]))
+					break;
+				++pos;
+			}
+			if (!m_columnMap.Build(keys))
+				return false;
+			// Columns that repeat an earlier name are skipped, so the map is rebuilt from only the
+			// first appearance of each name to number the table's columns
+			if (m_columnMap.Size() != keys.size())
+			{
+				Vector<std::string_view> uniqueKeys;
+				for (size_t key = 0; key < keys.size(); ++key)
+				{
+					if (m_columnMap.Find(keys[key], Detail::HashString(keys[key])) == key)
+						uniqueKeys.push_back(keys[key]);
+				}
+				if (!m_columnMap.Build(uniqueKeys))
+					return false;
+			}
+			Detail::AdvanceToNextLine(text, pos);
+			// If this assert hits, your data is malformed, since an interior double-quote was not
+			// followed by a second quote
+			assert(!malformed);
+
+			// Map each column in the text to its table column.  Columns that weren't requested, or
+			// that repeat an earlier name, are skipped.
+			context.columns.clear();
+			size_t nextColumn = 0;
+			for (const auto & name : names)
+			{
+				const size_t index = m_columnMap.Find(name, Detail::HashString(name));
+				context.columns.push_back(index == nextColumn ? nextColumn++ : ReadContext::Skipped);
+			}
+			for (std::string_view name : options.columns)
+			{
+				if (m_columnMap.Find(name, Detail::HashString(name)) == StringIndexMap::NotFound)
+					return false;
+			}
+
+			// Filter columns are found among all columns, since they may not be loaded
+			if (options.filter)
+			{
+				context.filter = &options.filter;
+				for (std::string_view name : options.filterColumns)
+				{
+					const auto it = std::find(names.begin(), names.end(), name);
+					if (it == names.end())
+						return false;
+					const size_t column = static_cast<size_t>(std::distance(names.begin(), it));
+					if (column == 0)
+						context.filterNameIndex = context.filterColumns.size();
+					context.filterColumns.push_back(column);
+					context.lastFilterColumn = std::max(context.lastFilterColumn, column);
+				}
+			}
+			return true;
+		}
+
+		void AppendCell(const Detail::Cell & cell, size_t column, const ReadContext & context, VectorColumn & columns, StringPool & pool) const
+		{
+			const size_t index = column < context.columns.size() ? context.columns[column] : ReadContext::Skipped;
+			if (index == ReadContext::Skipped)
+				return;
+			TableData data;
+			if (index == 0 || !ParseNumber(cell, context.format, data))
+				data = ToCellString(cell, pool);
+			columns[index].Append(std::move(data));
+		}
+
+		// Calls the row filter with the row's filter columns, which must all have been read
+		bool Filter(const ReadContext & context, FilterState & state) const
+		{
+			// Escaped cells are unescaped into scratch storage, which is reserved up front so
+			// the cells' views remain valid.
+			size_t escapedSize = 0;
+			for (size_t column : context.filterColumns)
+				escapedSize += state.pending[column].escaped ? state.pending[column].text.size() : 0;
+			state.unescaped.clear();
+			state.unescaped.reserve(escapedSize);
+			state.cells.clear();
+			for (size_t column : context.filterColumns)
+			{
+				Detail::Cell cell = state.pending[column];
+				if (cell.escaped)
+				{
+					const size_t offset = state.unescaped.size();
+					Detail::AppendUnescaped(state.unescaped, cell.text);
+					cell.text = std::string_view(state.unescaped.data() + offset, state.unescaped.size() - offset);
+				}
+				state.cells.push_back(cell);
+			}
+			return (*context.filter)(RowView(state.cells.data(), state.cells.size(), context.format, context.filterNameIndex));
+		}
+
+		bool ReadRow(Detail::Scanner & scanner, size_t & pos, const ReadContext & context, VectorColumn & columns, StringPool & pool, FilterState & state, bool & malformed) const
+		{
+			std::string_view text = scanner.GetText();
+
+			// Track column data.  Skipped cells are still parsed to find their end, but are
+			// otherwise ignored.  If rows are filtered, cells are held until the filter accepts
+			// the row, and all remaining cells of a rejected row are skipped.
+			size_t column = 0;
+			bool accepted = !context.filter;
+			bool rejected = false;
+			state.pending.clear();
+			while (pos < text.size())
+			{
+				auto cell = Detail::ParseCell(scanner, pos, malformed);
+				if (accepted)
+					AppendCell(cell, column, context, columns, pool);
+				else if (!rejected)
+				{
+					state.pending.push_back(cell);
+					if (column == context.lastFilterColumn)
+					{
+						accepted = Filter(context, state);
+						rejected = !accepted;
+						for (size_t pending = 0; accepted && pending < state.pending.size(); ++pending)
+							AppendCell(state.pending[pending], pending, context, columns, pool);
+					}
+				}
+				++column;
+				if (pos == text.size() || Detail::IsLineEnd(text[pos]))
+					break;
+				++pos;
+			}
+			Detail::AdvanceToNextLine(text, pos);
+			return column == context.columns.size();
+		}
+
+		// Reads rows until reaching the end position.  Speculative reads may begin at a false row
+		// boundary, and so fail on malformed quotes instead of asserting.
+		bool ReadRows(Detail::Scanner & scanner, size_t & pos, size_t end, const ReadContext & context, VectorColumn & columns, StringPool & pool, bool speculative = false) const
+		{
+			bool malformed = false;
+			FilterState state;
+			while (pos < end)
+			{
+				if (!ReadRow(scanner, pos, context, columns, pool, state, malformed))
+					return false;
+				if (malformed && speculative)
+					return false;
+				// If this assert hits, your data is malformed, since an interior double-quote was not
+				// followed by a second quote
+				assert(!malformed);
+			}
+			return true;
+		}
+
+		// Returns true if the rows from pos end exactly at the end position without malformed
+		// quotes.  If pos is a true row start, this confirms that end is one as well.
+		bool SkipRows(Detail::Scanner & scanner, size_t pos, size_t end) const
+		{
+			std::string_view text = scanner.GetText();
+			bool malformed = false;
+			while (pos < end && !malformed)
+			{
+				while (true)
+				{
+					Detail::ParseCell(scanner, pos, malformed);
+					if (pos == text.size() || Detail::IsLineEnd(text[pos]))
+						break;
+					++pos;
+				}
+				Detail::AdvanceToNextLine(text, pos);
+			}
+			return pos == end && !malformed;
+		}
+
+		// Sets the number of rows each column should reserve space for, from a fast count of the
+		// rows in [begin, end).  Filtered rows are usually a small fraction of the text, so no
+		// space is reserved for them.
+		void ExpectRows(const Detail::Scanner & scanner, size_t begin, size_t end, const ReadContext & context, VectorColumn & columns) const
+		{
+			if (context.filter)
+				return;
+			const size_t rows = scanner.EstimateRows(begin, end);
+			for (auto & column : columns)
+				column.expectedSize = rows;
+		}
+
+		// Returns the start of the first row beginning after pos, given whether pos lies inside a quoted cell
+		size_t FindRowStart(Detail::Scanner & scanner, size_t pos, bool quoted) const
+		{
+			std::string_view text = scanner.GetText();
+			while (pos < text.size())
+			{
+				if (quoted)
+				{
+					pos = scanner.FindQuote(pos);
+					if (pos == text.size())
+						break;
+					quoted = false;
+					++pos;
+					continue;
+				}
+				const size_t lineEnd = scanner.FindLineEnd(pos);
+				const size_t quote = scanner.FindQuote(pos);
+				if (lineEnd < quote)
+				{
+					pos = lineEnd;
+					Detail::AdvanceToNextLine(text, pos);
+					return pos;
+				}
+				pos = quote;
+				if (pos == text.size())
+					break;
+				quoted = true;
+				++pos;
+			}
+			return text.size();
+		}
+
+		bool ReadRowsParallel(std::string_view text, size_t pos, const ReadContext & context, size_t threads, StringPool & pool)
+		{
+			struct Chunk
+			{
+				size_t begin = 0;
+				size_t end = 0;
+				size_t quotes = 0;
+				VectorColumn columns;
+				StringPool pool;
+				Arena * arena = nullptr;
+				bool valid = false;
+			};
+
+			// Divide the remaining text into equally sized chunks, and count the quotes in each
+			// one so we know whether each chunk starts inside a quoted cell.
+			const size_t size = text.size() - pos;
+			const size_t chunkCount = std::min(threads, size / Options::MinParallelChunkSize);
+			if (chunkCount <= 1)
+				return false;
+			std::vector<Chunk> chunks(chunkCount);
+			for (size_t i = 0; i < chunkCount; ++i)
+				chunks[i].begin = pos + (size * i) / chunkCount;
+			Detail::ParallelFor(chunkCount, threads, [&](size_t i)
+			{
+				Detail::Scanner scanner(text, context.delimiter);
+				const size_t end = (i + 1 < chunkCount) ? chunks[i + 1].begin : text.size();
+				chunks[i].quotes = scanner.CountQuotes(chunks[i].begin, end);
+			});
+
+			// Move each chunk boundary forward to the next line end that isn't inside quotes
+			size_t quotes = 0;
+			for (size_t i = 1; i < chunkCount; ++i)
+			{
+				quotes += chunks[i - 1].quotes;
+				Detail::Scanner scanner(text, context.delimiter);
+				chunks[i].begin = std::max(FindRowStart(scanner, chunks[i].begin, quotes % 2 != 0), chunks[i - 1].begin);
+			}
+			for (size_t i = 0; i < chunkCount; ++i)
+				chunks[i].end = (i + 1 < chunkCount) ? chunks[i + 1].begin : text.size();
+
+			// The filter must only be called for real rows, so if rows are filtered, every chunk
+			// boundary is confirmed to be a true row start before any rows are read.  The first
+			// chunk starts at a true row start, so each boundary is confirmed in turn if the rows of
+			// the chunk before it end exactly on it.
+			if (context.filter)
+			{
+				Detail::ParallelFor(chunkCount - 1, threads, [&](size_t i)
+				{
+					Detail::Scanner scanner(text, context.delimiter);
+					chunks[i].valid = SkipRows(scanner, chunks[i].begin, chunks[i].end);
+				});
+				for (size_t i = 0; i + 1 < chunkCount; ++i)
+				{
+					if (!chunks[i].valid)
+						return false;
+				}
+			}
+			if (m_arena)
+			{
+				for (auto & chunk : chunks)
+					chunk.arena = &m_arena->CreateChild();
+			}
+
+			// Parse each chunk independently.  A chunk is only valid if its rows end exactly on
+			// the next chunk's boundary, which confirms that boundary was a true row start.
+			Detail::ParallelFor(chunkCount, threads, [&](size_t i)
+			{
+				// Each chunk allocates from its own arena, since arenas aren't thread-safe
+				Chunk & chunk = chunks[i];
+				Arena::Scope scope(chunk.arena);
+				chunk.columns = VectorColumn(GetNumColumns());
+				chunk.pool = StringPool();
+				Detail::Scanner scanner(text, context.delimiter);
+				ExpectRows(scanner, chunk.begin, chunk.end, context, chunk.columns);
+				size_t current = chunk.begin;
+				chunk.valid = ReadRows(scanner, current, chunk.end, context, chunk.columns, chunk.pool, true) && current == chunk.end;
+			});
+
+			// Stitch chunk columns together in order
+			size_t rows = 0;
+			for (const auto & chunk : chunks)
+			{
+				if (!chunk.valid)
+					return false;
+				rows += chunk.columns[0].Size();
+			}
+			for (size_t column = 0; column < GetNumColumns(); ++column)
+			{
+				for (size_t i = 0; i < chunkCount; ++i)
+				{
+					m_columns[column].Append(std::move(chunks[i].columns[column]));
+					if (i == 0)
+						m_columns[column].Reserve(rows);
+				}
+			}
+			for (auto & chunk : chunks)
+				pool.splice(pool.end(), chunk.pool);
+			return true;
+		}
+
+		// Builds a table with a row for each distinct value of the key column, in order of first
+		// appearance, and a column for each aggregation of that group's rows.
+		Table AggregateGroups(size_t keyColumnIndex, const std::vector<Aggregation> & aggregations, size_t threads) const
+		{
+			Table table;
+			Vector<const Column *> columns(aggregations.size(), nullptr);
+			for (size_t index = 0; index < aggregations.size(); ++index)
+			{
+				const std::string_view name = aggregations[index].column;
+				if (name.empty() && aggregations[index].function == AggregateFunction::Count)
+					continue;
+				const size_t columnIndex = m_columnMap.Find(name, Detail::HashString(name));
+				if (columnIndex == StringIndexMap::NotFound)
+				{
+					table.m_error = true;
+					return table;
+				}
+				columns[index] = &m_columns[columnIndex];
+			}
+
+			// Accumulate each range of rows separately, and merge the partial aggregates in order
+			const Column & keyColumn = m_columns[keyColumnIndex];
+			const size_t rowCount = keyColumn.Size();
+			const size_t rangeCount = std::max<size_t>(std::min(Detail::GetThreadCount(threads), rowCount / GroupAggregator::MinParallelGroupSize), 1);
+			Arena::Scope heapScope(nullptr);
+			Vector<GroupAggregator> partials(rangeCount, GroupAggregator(keyColumn, columns));
+			Detail::ParallelFor(rangeCount, threads, [&](size_t range)
+			{
+				partials[range].AddRows(rowCount * range / rangeCount, rowCount * (range + 1) / rangeCount);
+			});
+			GroupAggregator & groups = partials[0];
+			for (size_t range = 1; range < rangeCount; ++range)
+				groups.Merge(partials[range]);
+
+			Arena::Scope scope(table.CreateArena());
+			StringPool names;
+			Vector<std::string_view> keys;
+			m_columnMap.ForEach([&](std::string_view name, size_t index)
+			{
+				if (index == keyColumnIndex)
+					keys.push_back(name);
+			});
+			const char * functionNames[] = { "Count", "Sum", "Min", "Max", "Mean" };
+			for (const Aggregation & aggregation : aggregations)
+			{
+				String name(aggregation.name);
+				if (name.empty())
+				{
+					name = functionNames[static_cast<size_t>(aggregation.function)];
+					if (!aggregation.column.empty())
+						name.append("(").append(aggregation.column).append(")");
+				}
+				names.push_back(std::move(name));
+				keys.push_back(names.back());
+			}
+			const bool indexed = table.m_columnMap.Build(keys);
+			table.m_columns.resize(keys.size());
+			const size_t groupCount = groups.firstRows.size();
+			for (Column & column : table.m_columns)
+				column.expectedSize = groupCount;
+
+			// Name each group by its key's text
+			StringPool pool;
+			for (uint32_t row : groups.firstRows)
+			{
+				const CellKey key = keyColumn.GetKey(row);
+				String text;
+				if (key.type == ColumnType::Integer)
+					text = String(std::to_string(key.intValue));
+				else if (key.type == ColumnType::Double)
+					text = String(Detail::FormatDouble(key.doubleValue));
+				else
+					text = String(key.text);
+				if constexpr (OwnsStrings)
+					table.m_columns[0].Append(std::move(text));
+				else
+				{
+					pool.push_back(std::move(text));
+					table.m_columns[0].Append(std::string_view(pool.back()));
+				}
+			}
+			if (!pool.empty())
+				table.m_stringPool = std::make_shared<const StringPool>(std::move(pool));
+
+			const double none = std::numeric_limits<double>::quiet_NaN();
+			for (size_t index = 0; index < aggregations.size(); ++index)
+			{
+				Column & column = table.m_columns[index + 1];
+				const bool integers = columns[index] && columns[index]->type == ColumnType::Integer;
+				for (size_t group = 0; group < groupCount; ++group)
+				{
+					const auto & values = groups.accumulators[group * aggregations.size() + index];
+					const size_t count = values.intCount + values.doubleCount;
+					const double sum = static_cast<double>(static_cast<int64_t>(values.intSum)) + values.doubleSum;
+					switch (aggregations[index].function)
+					{
+						case AggregateFunction::Count:
+							column.Append(static_cast<int64_t>(columns[index] ? count : groups.rowCounts[group]));
+							break;
+						case AggregateFunction::Sum:
+							if (integers)
+								column.Append(static_cast<int64_t>(values.intSum));
+							else
+								column.Append(sum);
+							break;
+						case AggregateFunction::Min:
+							if (integers)
+								column.Append(values.intMin);
+							else if (count == 0)
+								column.Append(none);
+							else
+								column.Append(std::min(values.intCount ? static_cast<double>(values.intMin) : values.doubleMin, values.doubleMin));
+							break;
+						case AggregateFunction::Max:
+							if (integers)
+								column.Append(values.intMax);
+							else if (count == 0)
+								column.Append(none);
+							else
+								column.Append(std::max(values.intCount ? static_cast<double>(values.intMax) : values.doubleMax, values.doubleMax));
+							break;
+						default:
+							column.Append(count ? sum / static_cast<double>(count) : none);
+							break;
+					}
+				}
+			}
+			table.m_error = !indexed || !table.IndexRows() || table.GetNumColumns() != keys.size() || table.GetNumRows() != groupCount;
+			return table;
+		}
+
+		// Creates the table's arena if its allocator uses one, and recreates its containers so
+		// they allocate from the arena.  Returns the arena, or null if the table doesn't use one.
+		Arena * CreateArena()
+		{
+			if constexpr (UsesArena)
+			{
+				m_arena = std::make_shared<Arena>();
+				Arena::Scope scope(m_arena.get());
+				m_columns = VectorColumn();
+				m_columnMap = StringIndexMap();
+				m_rowMap = StringIndexMap();
+			}
+			return m_arena.get();
+		}
+
+		// Dictionary encodes string columns with few distinct values.  The first column is never
+		// encoded, since it names each row.
+		bool EncodeColumns(double maxRatio)
+		{
+			for (size_t column = 1; column < m_columns.size(); ++column)
+			{
+				if (!m_columns[column].Encode(maxRatio))
+					return false;
+			}
+			return true;
+		}
+
+		// Builds the row index from the first column
+		bool IndexRows()
+		{
+			Arena::Scope scope(nullptr);
+			const auto & rowNames = m_columns[0].strings;
+			return m_rowMap.Build(Vector<std::string_view>(rowNames.begin(), rowNames.end()));
+		}
+
+		// Reads a snapshot without parsing, encoding, or hashing anything again.  Numeric columns,
+		// codes, mixed cells, and name maps are viewed in place if requested, and copied otherwise.
+		// Every offset and index is validated, so a corrupt snapshot is rejected rather than read
+		// out of bounds.
+		bool ReadSnapshot(std::string_view snapshot, bool inPlace)
+		{
+			Detail::SnapshotReader reader(snapshot, inPlace);
+			Detail::SnapshotHeader header;
+			if (!reader.Read(header))
 				return false;
-			if (!ReadRows(text, current, delimiter, format))
+			if (header.magic != Detail::SnapshotHeader::Magic || header.version != Detail::SnapshotHeader::Version ||
+				header.byteOrder != Detail::SnapshotHeader::ByteOrder)
 				return false;
-			return true;
+			if (header.poolOffset > snapshot.size() || header.poolSize != snapshot.size() - header.poolOffset)
+				return false;
+			if (header.checksum != Detail::Checksum(snapshot.data() + sizeof(header), snapshot.size() - sizeof(header)))
+				return false;
+			if (header.columnCount == 0 || header.columnCount > snapshot.size())
+				return false;
+
+			const std::string_view pool = snapshot.substr(static_cast<size_t>(header.poolOffset));
+			auto readStrings = [&](Column & column, uint64_t count)
+			{
+				Detail::Array<Detail::SnapshotString, Alloc> refs;
+				if (!reader.ReadArray(refs, count))
+					return false;
+				column.strings.reserve(refs.size());
+				for (const auto & ref : refs)
+				{
+					if (ref.offset > pool.size() || ref.size > pool.size() - ref.offset)
+						return false;
+					column.strings.emplace_back(pool.substr(static_cast<size_t>(ref.offset), static_cast<size_t>(ref.size)));
+				}
+				return true;
+			};
+
+			Arena::Scope scope(CreateArena());
+			m_columns.resize(static_cast<size_t>(header.columnCount));
+			if (!m_columnMap.Read(reader, m_columns.size()) || m_columnMap.Size() != m_columns.size())
+				return false;
+			for (Column & column : m_columns)
+			{
+				Detail::SnapshotColumn columnHeader;
+				if (!reader.Read(columnHeader))
+					return false;
+				if (columnHeader.type > static_cast<uint64_t>(ColumnType::Mixed) || columnHeader.size > snapshot.size() ||
+					columnHeader.stringCount > snapshot.size())
+					return false;
+				column.type = static_cast<ColumnType>(columnHeader.type);
+				const size_t stringCount = static_cast<size_t>(columnHeader.stringCount);
+				switch (column.type)
+				{
+					case ColumnType::Integer:
+						if (!reader.ReadArray(column.ints, columnHeader.size))
+							return false;
+						break;
+					case ColumnType::Double:
+						if (!reader.ReadArray(column.doubles, columnHeader.size))
+							return false;
+						break;
+					case ColumnType::String:
+						if (columnHeader.encoded)
+						{
+							if (columnHeader.size == 0 || !reader.ReadArray(column.codes, columnHeader.size) || !readStrings(column, stringCount))
+								return false;
+							if (!column.dictionary.Read(reader, stringCount) || column.dictionary.Size() != stringCount)
+								return false;
+							for (uint32_t code : column.codes)
+							{
+								if (code >= stringCount)
+									return false;
+							}
+						}
+						else if (stringCount != columnHeader.size || !readStrings(column, stringCount))
+							return false;
+						break;
+					case ColumnType::Mixed:
+					{
+						// Cells are viewed in place if their layout matches, and converted otherwise
+						if constexpr (MixedCellMatchesSnapshot)
+						{
+							if (!reader.ReadArray(column.mixed, columnHeader.size))
+								return false;
+						}
+						else
+						{
+							Detail::Array<Detail::SnapshotMixedCell, Alloc> cells;
+							if (!reader.ReadArray(cells, columnHeader.size))
+								return false;
+							column.mixed.reserve(cells.size());
+							for (const auto & cell : cells)
+							{
+								MixedCell mixedCell = MixedCell::String(static_cast<size_t>(cell.value));
+								if (cell.type == static_cast<uint32_t>(ColumnType::Integer))
+									mixedCell = MixedCell::Integer(static_cast<int64_t>(cell.value));
+								else if (cell.type == static_cast<uint32_t>(ColumnType::Double))
+									std::memcpy(&mixedCell.doubleValue, &cell.value, sizeof(double));
+								mixedCell.type = static_cast<ColumnType>(cell.type);
+								column.mixed.push_back(mixedCell);
+							}
+						}
+						for (const MixedCell & cell : column.mixed)
+						{
+							if (cell.type != ColumnType::Integer && cell.type != ColumnType::Double &&
+								(cell.type != ColumnType::String || cell.stringIndex >= stringCount))
+								return false;
+						}
+						if (!readStrings(column, stringCount))
+							return false;
+						break;
+					}
+					default:
+						if (columnHeader.size != 0)
+							return false;
+						break;
+				}
+			}
+			if (m_columns[0].type != ColumnType::String && m_columns[0].type != ColumnType::Empty)
+				return false;
+			for (const auto & column : m_columns)
+			{
+				if (column.Size() != m_columns[0].Size())
+					return false;
+			}
+			// Each row name must map to a row with that name, so there can't be more names than rows
+			const size_t rowCount = m_columns[0].Size();
+			if (!m_rowMap.Read(reader, rowCount) || m_rowMap.Size() > rowCount)
+				return false;
+			bool rowsMatch = true;
+			m_rowMap.ForEach([&](std::string_view name, size_t row) { rowsMatch = rowsMatch && name == m_columns[0].strings[row]; });
+			return rowsMatch && reader.GetPosition() == header.poolOffset;
+		}
+
+		bool Read(std::string_view text, const Options & options)
+		{
+			ReadContext context;
+			if (!Detail::DetectDelimiter(text, context.delimiter, context.format))
+				return false;
+			Arena::Scope scope(CreateArena());
+			Detail::Scanner scanner(text, context.delimiter);
+			size_t pos = 0;
+			if (!ReadHeader(scanner, pos, options, context))
+				return false;
+			m_columns.resize(GetNumColumns());
+			StringPool pool;
+			const size_t threads = Detail::GetThreadCount(options.threads);
+			if (threads <= 1 || !ReadRowsParallel(text, pos, context, threads, pool))
+			{
+				ExpectRows(scanner, pos, text.size(), context, m_columns);
+				if (!ReadRows(scanner, pos, text.size(), context, m_columns, pool))
+					return false;
+			}
+			if (!pool.empty())
+				m_stringPool = std::make_shared<const StringPool>(std::move(pool));
+			return EncodeColumns(options.dictionaryRatio) && IndexRows();
 		}
 
-		VectorTableData m_tableData;
+		// Arena owning all memory allocated by the table, if its allocator uses one.  This is
+		// declared first so it's destroyed after every container using it.
+		std::shared_ptr<Arena> m_arena;
+		VectorColumn m_columns;
+		// Hash index for each column, which is empty until built
+		Vector<HashIndex> m_hashIndexes;
+		// Range index for each column, which is empty until built
+		Vector<RangeIndex> m_rangeIndexes;
+		// Escaped strings referred to by std::string_view cells, shared between copies of the table
+		std::shared_ptr<const StringPool> m_stringPool;
+		// Mapped file containing the text or snapshot data that the table refers to
+		std::shared_ptr<const Detail::MappedFile> m_file;
 		StringIndexMap m_columnMap;
 		StringIndexMap m_rowMap;
 		bool m_error = false;
 	};
 
+	// TableView stores string cells as views into the source text, so the text must outlive the
+	// table.  Only cells containing escaped quotes are copied.
+	template<typename Alloc = std::allocator<char>>
+	using TableView = Table<Alloc, std::string_view>;
+
+	// Pair of row indices joined by a JoinView
+	struct JoinedRow
+	{
+		uint32_t left;
+		uint32_t right;
+	};
+
+	// JoinView holds the pairs of left and right rows with equal values in their join columns,
+	// without copying any cells.  Rows are ordered by left row, and then by right row.  Both
+	// tables must outlive the view.
+	//   auto stats = Join(items, "StatId", itemStats, "StatId");
+	//   for (const auto & row : stats)
+	//       Process(items.Get<String>(row.left, "Name"), itemStats.Get<int64_t>(row.right, "Damage"));
+	template<typename Alloc = std::allocator<char>, typename CellString = std::basic_string<char, std::char_traits<char>, Alloc>>
+	class JoinView
+	{
+	public:
+		using TableType = Table<Alloc, CellString>;
+	private:
+		template<typename T>
+		using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+		using Column = typename TableType::Column;
+	public:
+
+		// Joins the tables using a hash index over the join column of the table with fewer rows,
+		// or that table's existing index if BuildIndex() has been called for the column, and
+		// looks up each row of the other table.  Values only match cells of the same type.
+		JoinView(const TableType & left, size_t leftColumnIndex, const TableType & right, size_t rightColumnIndex) :
+			m_left(&left), m_right(&right), m_rightColumnIndex(rightColumnIndex)
+		{
+			assert(left && right);
+			assert(leftColumnIndex < left.GetNumColumns());
+			assert(rightColumnIndex < right.GetNumColumns());
+			const Column & leftColumn = left.m_columns[leftColumnIndex];
+			const Column & rightColumn = right.m_columns[rightColumnIndex];
+			const bool buildLeft = leftColumn.Size() < rightColumn.Size();
+			const TableType & build = buildLeft ? left : right;
+			const size_t buildColumnIndex = buildLeft ? leftColumnIndex : rightColumnIndex;
+			const Column & buildColumn = buildLeft ? leftColumn : rightColumn;
+			const Column & probeColumn = buildLeft ? rightColumn : leftColumn;
+
+			typename TableType::HashIndex joinIndex;
+			const typename TableType::HashIndex * index = &joinIndex;
+			if (build.HasIndex(buildColumnIndex))
+				index = &build.m_hashIndexes[buildColumnIndex];
+			else
+			{
+				Arena::Scope scope(nullptr);
+				joinIndex.Build(buildColumn);
+			}
+
+			for (size_t row = 0; row < probeColumn.Size(); ++row)
+			{
+				const uint32_t probeRow = static_cast<uint32_t>(row);
+				for (uint32_t buildRow : index->Find(buildColumn, probeColumn.GetKey(row)))
+					m_rows.push_back(buildLeft ? JoinedRow{ buildRow, probeRow } : JoinedRow{ probeRow, buildRow });
+			}
+
+			// Rows found by probing the right table are reordered by left row with a stable counting sort
+			if (buildLeft && !m_rows.empty())
+			{
+				Vector<size_t> starts(leftColumn.Size() + 1, 0);
+				for (const JoinedRow & row : m_rows)
+					++starts[row.left + 1];
+				for (size_t i = 1; i < starts.size(); ++i)
+					starts[i] += starts[i - 1];
+				Vector<JoinedRow> sorted(m_rows.size());
+				for (const JoinedRow & row : m_rows)
+					sorted[starts[row.left]++] = row;
+				m_rows = std::move(sorted);
+			}
+		}
+
+		const TableType & GetLeft() const { return *m_left; }
+		const TableType & GetRight() const { return *m_right; }
+
+		const JoinedRow * begin() const { return m_rows.data(); }
+		const JoinedRow * end() const { return m_rows.data() + m_rows.size(); }
+		size_t size() const { return m_rows.size(); }
+		bool empty() const { return m_rows.empty(); }
+		const JoinedRow & operator[](size_t index) const
+		{
+			assert(index < m_rows.size());
+			return m_rows[index];
+		}
+
+		// Copies the joined rows into a new table holding every left column, followed by every
+		// right column except the right join column, whose values match the left join column.
+		// Right columns with the same name as a left column are named with the given prefix.
+		// Rows are named by the left table, so lookups by the name of a left row joined to several
+		// right rows find the first.
+		TableType ToTable(const Options & options = Options(), std::string_view rightPrefix = "Right ") const
+		{
+			TableType table;
+			Arena::Scope scope(table.CreateArena());
+
+			// Select each table's columns in order, along with their names
+			struct Source
+			{
+				const Column * column;
+				bool left;
+			};
+			Vector<std::string_view> names;
+			Vector<Source> sources;
+			typename TableType::StringPool prefixedNames;
+			auto addColumns = [&](const TableType & source, bool left)
+			{
+				Vector<std::string_view> sourceNames(source.GetNumColumns());
+				source.m_columnMap.ForEach([&](std::string_view name, size_t index) { sourceNames[index] = name; });
+				for (size_t index = 0; index < sourceNames.size(); ++index)
+				{
+					std::string_view name = sourceNames[index];
+					if (!left && index == m_rightColumnIndex)
+						continue;
+					if (!left && m_left->m_columnMap.Find(name, Detail::HashString(name)) != TableType::StringIndexMap::NotFound)
+					{
+						prefixedNames.emplace_back(rightPrefix);
+						prefixedNames.back().append(name);
+						name = prefixedNames.back();
+					}
+					names.push_back(name);
+					sources.push_back({ &source.m_columns[index], left });
+				}
+			};
+			addColumns(*m_left, true);
+			addColumns(*m_right, false);
+
+			const bool indexed = table.m_columnMap.Build(names);
+			table.m_columns.resize(sources.size());
+			typename TableType::StringPool pool;
+			for (size_t index = 0; index < sources.size(); ++index)
+			{
+				typename TableType::Column & column = table.m_columns[index];
+				column.expectedSize = m_rows.size();
+				for (const JoinedRow & row : m_rows)
+				{
+					auto data = sources[index].column->GetData(sources[index].left ? row.left : row.right);
+					if constexpr (!TableType::OwnsStrings)
+					{
+						// String cells are copied into the new table's pool, since the view refers to the source tables
+						if (data.index() == StringType)
+						{
+							pool.emplace_back(std::get<CellString>(data));
+							data = std::string_view(pool.back());
+						}
+					}
+					column.Append(std::move(data));
+				}
+			}
+			if (!pool.empty())
+				table.m_stringPool = std::make_shared<const typename TableType::StringPool>(std::move(pool));
+			table.m_error = !indexed || table.GetNumColumns() != names.size() || !table.EncodeColumns(options.dictionaryRatio) ||
+				!table.IndexRows() || table.GetNumRows() != m_rows.size();
+			return table;
+		}
+
+	private:
+		const TableType * m_left;
+		const TableType * m_right;
+		size_t m_rightColumnIndex;
+		Vector<JoinedRow> m_rows;
+	};
+
+	// Joins two tables on a column of each, pairing the rows with equal values
+	template<typename Alloc, typename CellString>
+	JoinView<Alloc, CellString> Join(const Table<Alloc, CellString> & left, const Name & leftColumnName, const Table<Alloc, CellString> & right, const Name & rightColumnName)
+	{
+		return JoinView<Alloc, CellString>(left, left.GetColumnIndex(leftColumnName), right, right.GetColumnIndex(rightColumnName));
+	}
+
+	// Errors reported for each table loaded by a TableSet
+	enum class LoadError
+	{
+		None,
+		File,
+		Parse,
+	};
+
+	// TableSet loads a set of named tables from files, parsing several files at once, so a
+	// large set of tables loads in roughly the time taken by its largest file.  Each table
+	// records its own error, so a missing or malformed file doesn't prevent the rest of the
+	// set from loading.
+	//   TableSet<> tables({ { "Items", "Data/Items.csv" }, { "Monsters", "Data/Monsters.csv" } });
+	//   const auto & items = tables.GetTable("Items");
+	template<typename Alloc = std::allocator<char>, typename CellString = std::basic_string<char, std::char_traits<char>, Alloc>>
+	class TableSet
+	{
+	public:
+		using TableType = Table<Alloc, CellString>;
+		using File = std::pair<std::string_view, std::string_view>;
+	private:
+		template<typename T>
+		using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+	public:
+
+		// Loads each file, given as a (name, path) pair, using up to the requested number of
+		// threads, or all hardware threads if zero.  Each file is parsed by a single thread
+		// with the given options, so options.threads should normally be left at one.  Each table
+		// should have a unique name.  If a name is repeated, the set reports an error, and lookups
+		// by that name find the first table with it.
+		explicit TableSet(const std::vector<File> & files, size_t threads = 0, const Options & options = Options())
+		{
+			const size_t count = files.size();
+			Vector<std::string_view> names(count);
+			Vector<std::shared_ptr<const Detail::MappedFile>> mappedFiles(count);
+			Vector<size_t> order(count);
+			for (size_t index = 0; index < count; ++index)
+			{
+				names[index] = files[index].first;
+				mappedFiles[index] = std::make_shared<const Detail::MappedFile>(files[index].second);
+				order[index] = index;
+			}
+
+			// Start the largest files first, so no large file is left to be parsed alone at the end
+			std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+			{
+				return mappedFiles[a]->GetText().size() > mappedFiles[b]->GetText().size();
+			});
+			m_tables.resize(count);
+			m_errors.resize(count, LoadError::None);
+			Detail::ParallelFor(count, threads, [&](size_t i)
+			{
+				const size_t index = order[i];
+				const bool mapped = static_cast<bool>(*mappedFiles[index]);
+				m_tables[index].emplace(TableType::FromMappedFile(std::move(mappedFiles[index]), options));
+				if (!*m_tables[index])
+					m_errors[index] = mapped ? LoadError::Parse : LoadError::File;
+			});
+
+			m_names.assign(names.begin(), names.end());
+			m_indexed = m_nameMap.Build(names) && m_nameMap.Size() == count;
+		}
+
+		// Returns true if every table loaded without error, and each table has a unique name
+		explicit operator bool() const
+		{
+			return m_indexed && std::all_of(m_errors.begin(), m_errors.end(), [](LoadError error) { return error == LoadError::None; });
+		}
+
+		size_t GetNumTables() const { return m_tables.size(); }
+		size_t GetTableIndex(const Name & tableName) const
+		{
+			const size_t index = m_nameMap.Find(tableName.GetName(), tableName.GetHash());
+			assert(index != StringIndexMap::NotFound);
+			return index;
+		}
+		std::string_view GetName(size_t tableIndex) const
+		{
+			assert(tableIndex < GetNumTables());
+			return m_names[tableIndex];
+		}
+		LoadError GetError(size_t tableIndex) const
+		{
+			assert(tableIndex < GetNumTables());
+			return m_errors[tableIndex];
+		}
+		LoadError GetError(const Name & tableName) const
+		{
+			return GetError(GetTableIndex(tableName));
+		}
+		const TableType & GetTable(size_t tableIndex) const
+		{
+			assert(tableIndex < GetNumTables());
+			return *m_tables[tableIndex];
+		}
+		const TableType & GetTable(const Name & tableName) const
+		{
+			return GetTable(GetTableIndex(tableName));
+		}
+
+		// Returns the named table, or nullptr if there's no table with that name or it failed to load
+		const TableType * FindTable(const Name & tableName) const
+		{
+			const size_t index = m_nameMap.Find(tableName.GetName(), tableName.GetHash());
+			if (index == StringIndexMap::NotFound || m_errors[index] != LoadError::None)
+				return nullptr;
+			return &*m_tables[index];
+		}
+
+	private:
+		using StringIndexMap = Detail::StringIndexMap<Alloc>;
+
+		Vector<std::optional<TableType>> m_tables;
+		Vector<LoadError> m_errors;
+		Vector<String> m_names;
+		StringIndexMap m_nameMap;
+		bool m_indexed = false;
+	};
+
+	// Reader parses text pushed to it in arbitrary chunks, and calls a function for each row
+	// instead of storing the table, so memory use is bounded by the longest row rather than
+	// the size of the input.  Chunks may end anywhere, including in the middle of a cell.
+	// Cells are parsed in the same way as Table, and the first row is read as the header.
+	//   Reader<> reader([](const Reader<>::Row & row) { Process(row.Get<int64_t>(1)); });
+	//   while (ReadChunk(chunk))
+	//       reader.Write(chunk);
+	//   reader.Finish();
+	template<typename Alloc = std::allocator<char>>
+	class Reader
+	{
+	public:
+		using String = std::basic_string<char, std::char_traits<char>, Alloc>;
+		using Row = RowView;
+	private:
+		template<typename T>
+		using Vector = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+	public:
+
+		using RowFunction = std::function<void(const Row &)>;
+
+		explicit Reader(RowFunction rowFunction) : m_rowFunction(std::move(rowFunction)) {}
+
+		// Parses all complete rows in the buffered text followed by the chunk, and keeps any
+		// incomplete row until more text arrives.  Only the new text of an incomplete row is
+		// scanned for its line end, so a long row written in small chunks is read in linear time.
+		void Write(std::string_view chunk)
+		{
+			if (m_error)
+				return;
+			m_buffer.append(chunk);
+			ReadRows(false);
+		}
+
+		// Parses any final row not followed by a line end.  Returns false if any error occurred.
+		bool Finish()
+		{
+			if (!m_error)
+				ReadRows(true);
+			m_buffer.clear();
+			// A table requires at least a header row
+			if (m_columnNames.empty())
+				m_error = true;
+			return !m_error;
+		}
+
+		// Returns false if the header has no delimiters, a row has the wrong number of cells,
+		// or a quoted cell is malformed.  No rows are read after an error.
+		explicit operator bool() const { return !m_error; }
+
+		// Column names are available once the header row has been read
+		size_t GetNumColumns() const { return m_columnNames.size(); }
+		size_t GetColumnIndex(std::string_view columnName) const
+		{
+			const auto it = std::find(m_columnNames.begin(), m_columnNames.end(), columnName);
+			assert(it != m_columnNames.end());
+			return static_cast<size_t>(it - m_columnNames.begin());
+		}
+
+	private:
+
+		void ReadRows(bool final)
+		{
+			// An incomplete row is only parsed again once its line end has arrived
+			if (m_pending)
+			{
+				if (!final && !ScanRow())
+					return;
+				m_pending = false;
+				m_scanPos = 0;
+			}
+
+			std::string_view text = m_buffer;
+			size_t pos = 0;
+			Detail::AdvanceToNextLine(text, pos);
+			size_t rowStart = pos;
+
+			// The delimiter is detected from the complete header line.  Text already searched for
+			// a line end isn't searched again.
+			if (m_columnNames.empty())
+			{
+				const size_t searched = std::max(pos, m_scanPos);
+				if (pos == text.size() || (!final && std::find_if(text.begin() + searched, text.end(), Detail::IsLineEnd) == text.end()))
+				{
+					m_buffer.erase(0, rowStart);
+					m_scanPos = m_buffer.size();
+					return;
+				}
+				m_scanPos = 0;
+				if (!Detail::DetectDelimiter(text.substr(pos), m_delimiter, m_format))
+				{
+					m_error = true;
+					return;
+				}
+			}
+
+			Detail::Scanner scanner(text, m_delimiter);
+			while (pos < text.size())
+			{
+				// A row is complete once its last cell is followed by a line end, or by the end of
+				// the final chunk.
+				bool malformed = false;
+				m_cells.clear();
+				while (true)
+				{
+					m_cells.push_back(Detail::ParseCell(scanner, pos, malformed));
+					if (pos == text.size() || Detail::IsLineEnd(text[pos]))
+						break;
+					++pos;
+				}
+				if (pos == text.size() && !final)
+				{
+					// Scan the incomplete row once, so later chunks only need to scan their own text
+					m_pending = true;
+					m_scanPos = rowStart;
+					m_scanState = ScanState::CellStart;
+					ScanRow();
+					m_scanPos -= rowStart;
+					break;
+				}
+				if (malformed || !ReadRow(text.substr(rowStart, pos - rowStart)))
+				{
+					m_error = true;
+					return;
+				}
+				Detail::AdvanceToNextLine(text, pos);
+				rowStart = pos;
+			}
+			m_buffer.erase(0, rowStart);
+		}
+
+		// States of a scan through an incomplete row, matching the way its cells are parsed
+		enum class ScanState
+		{
+			CellStart,
+			Unquoted,
+			Quoted,
+			QuoteEnd
+		};
+
+		// Continues scanning an incomplete row from the scan position, and returns true once
+		// the line end that completes the row is found
+		bool ScanRow()
+		{
+			const std::string_view text = m_buffer;
+			for (; m_scanPos < text.size(); ++m_scanPos)
+			{
+				const char c = text[m_scanPos];
+				switch (m_scanState)
+				{
+					case ScanState::Quoted:
+					{
+						// Delimiters and line ends are skipped until the next quote
+						const size_t quote = text.find('"', m_scanPos);
+						if (quote == std::string_view::npos)
+						{
+							m_scanPos = text.size();
+							return false;
+						}
+						m_scanPos = quote;
+						m_scanState = ScanState::QuoteEnd;
+						continue;
+					}
+					case ScanState::CellStart:
+						if (c == '"')
+						{
+							m_scanState = ScanState::Quoted;
+							continue;
+						}
+						break;
+					case ScanState::QuoteEnd:
+						// A quote not followed by a delimiter or line end is escaped, or malformed,
+						// and the cell continues
+						if (c != m_delimiter && !Detail::IsLineEnd(c))
+						{
+							m_scanState = ScanState::Quoted;
+							continue;
+						}
+						break;
+					default:
+						break;
+				}
+				if (Detail::IsLineEnd(c))
+					return true;
+				m_scanState = c == m_delimiter ? ScanState::CellStart : ScanState::Unquoted;
+			}
+			return false;
+		}
+
+		bool ReadRow(std::string_view rowText)
+		{
+			// Escaped cells are unescaped into scratch storage, which is reserved up front so
+			// the cells' views remain valid.
+			m_unescaped.clear();
+			m_unescaped.reserve(rowText.size());
+			for (auto & cell : m_cells)
+			{
+				if (!cell.escaped)
+					continue;
+				const size_t offset = m_unescaped.size();
+				Detail::AppendUnescaped(m_unescaped, cell.text);
+				cell.text = std::string_view(m_unescaped.data() + offset, m_unescaped.size() - offset);
+			}
+
+			if (m_columnNames.empty())
+			{
+				for (const auto & cell : m_cells)
+					m_columnNames.emplace_back(cell.text);
+				return true;
+			}
+			if (m_cells.size() != m_columnNames.size())
+				return false;
+			m_rowFunction(RowView(m_cells.data(), m_cells.size(), m_format, 0));
+			return true;
+		}
+
+		RowFunction m_rowFunction;
+		String m_buffer;
+		String m_unescaped;
+		Vector<Detail::Cell> m_cells;
+		Vector<String> m_columnNames;
+		// Scan position and state within an incomplete row, or the end of text searched for the
+		// header's line end
+		size_t m_scanPos = 0;
+		ScanState m_scanState = ScanState::CellStart;
+		bool m_pending = false;
+		char m_delimiter = 0;
+		Detail::Format m_format = Detail::Format::International;
+		bool m_error = false;
+	};
+
 }
 
 
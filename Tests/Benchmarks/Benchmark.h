@@ -0,0 +1,81 @@
+/*
+The Tbl library is distributed under the MIT License (MIT)
+https://opensource.org/licenses/MIT
+See the LICENSE file or Tbl.hpp for license details.
+Copyright (c) 2019 James Boer
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+// Tracks bytes allocated through CountingAllocator, along with the peak since the last reset
+struct MemoryCounter
+{
+	static inline std::atomic<size_t> current = 0;
+	static inline std::atomic<size_t> peak = 0;
+
+	static void Allocate(size_t size)
+	{
+		const size_t total = current += size;
+		size_t previous = peak;
+		while (previous < total && !peak.compare_exchange_weak(previous, total)) {}
+	}
+	static void Deallocate(size_t size) { current -= size; }
+
+	// Resets the peak, returning the current allocation size to measure from
+	static size_t ResetPeak()
+	{
+		peak = current.load();
+		return peak;
+	}
+};
+
+// Allocator used as a table's Alloc parameter to measure its memory use
+template<typename T>
+class CountingAllocator
+{
+public:
+	using value_type = T;
+
+	CountingAllocator() = default;
+	template<typename U>
+	CountingAllocator(const CountingAllocator<U> &) {}
+
+	T * allocate(size_t count)
+	{
+		MemoryCounter::Allocate(count * sizeof(T));
+		return std::allocator<T>().allocate(count);
+	}
+	void deallocate(T * data, size_t count)
+	{
+		MemoryCounter::Deallocate(count * sizeof(T));
+		std::allocator<T>().deallocate(data, count);
+	}
+
+	template<typename U>
+	bool operator == (const CountingAllocator<U> &) const { return true; }
+	template<typename U>
+	bool operator != (const CountingAllocator<U> &) const { return false; }
+};
+
+// Calls func repeatedly until both minimum counts are reached, returning the fastest call in seconds
+template<typename Func>
+double MeasureBest(Func func, size_t minIterations = 3, double minSeconds = 0.5)
+{
+	using Clock = std::chrono::steady_clock;
+	double best = 0.0;
+	double total = 0.0;
+	for (size_t iteration = 0; iteration < minIterations || total < minSeconds; ++iteration)
+	{
+		const auto start = Clock::now();
+		func();
+		const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		if (iteration == 0 || seconds < best)
+			best = seconds;
+		total += seconds;
+	}
+	return best;
+}
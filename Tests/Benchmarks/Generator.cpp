@@ -0,0 +1,110 @@
+/*
+The Tbl library is distributed under the MIT License (MIT)
+https://opensource.org/licenses/MIT
+See the LICENSE file or Tbl.hpp for license details.
+Copyright (c) 2019 James Boer
+*/
+
+#include "Generator.h"
+#include <random>
+
+namespace
+{
+	const char * Words[] =
+	{
+		"alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+		"india", "juliet", "kilo", "lima", "mike", "november", "oscar", "papa",
+	};
+
+	enum class CellKind
+	{
+		Integer,
+		Double,
+		Text,
+	};
+
+	CellKind GetCellKind(const GeneratorOptions & options, size_t column)
+	{
+		const size_t dataColumns = options.columns - 1;
+		const size_t numericColumns = static_cast<size_t>(options.numericFraction * dataColumns + 0.5);
+		if (column - 1 >= numericColumns)
+			return CellKind::Text;
+		return (column % 2) ? CellKind::Integer : CellKind::Double;
+	}
+
+	void AppendText(std::string & text, std::mt19937_64 & rng, const GeneratorOptions & options, char delimiter)
+	{
+		const size_t wordCount = 1 + rng() % 4;
+		const bool quoted = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < options.quoteDensity;
+		if (quoted)
+			text += '"';
+		for (size_t i = 0; i < wordCount; ++i)
+		{
+			if (i)
+				text += ' ';
+			text += Words[rng() % std::size(Words)];
+		}
+		if (quoted)
+		{
+			// Quoted cells contain a delimiter, and every other one an escaped quote
+			text += delimiter;
+			text += " more";
+			if (rng() % 2)
+				text += " \"\"quoted\"\"";
+			text += '"';
+		}
+	}
+}
+
+std::string GenerateTable(const GeneratorOptions & options)
+{
+	const char delimiter = options.continental ? ';' : ',';
+	std::mt19937_64 rng(options.seed);
+	std::string text;
+	for (size_t column = 0; column < options.columns; ++column)
+	{
+		if (column)
+			text += delimiter;
+		text += GetColumnName(column);
+	}
+	text += '\n';
+	for (size_t row = 0; row < options.rows; ++row)
+	{
+		text += GetRowName(row);
+		for (size_t column = 1; column < options.columns; ++column)
+		{
+			text += delimiter;
+			switch (GetCellKind(options, column))
+			{
+				case CellKind::Integer:
+					text += std::to_string(static_cast<int64_t>(rng() % 2000000) - 1000000);
+					break;
+				case CellKind::Double:
+				{
+					const uint64_t value = rng() % 100000000;
+					text += std::to_string(value / 1000);
+					text += options.continental ? ',' : '.';
+					std::string fraction = std::to_string(value % 1000);
+					text.append(3 - fraction.size(), '0');
+					text += fraction;
+					break;
+				}
+				case CellKind::Text:
+					AppendText(text, rng, options, delimiter);
+					break;
+			}
+		}
+		text += '\n';
+	}
+	return text;
+}
+
+std::string GetRowName(size_t row)
+{
+	return "Row " + std::to_string(row);
+}
+
+std::string GetColumnName(size_t column)
+{
+	return "Column " + std::to_string(column);
+}
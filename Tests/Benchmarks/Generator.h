@@ -0,0 +1,37 @@
+/*
+The Tbl library is distributed under the MIT License (MIT)
+https://opensource.org/licenses/MIT
+See the LICENSE file or Tbl.hpp for license details.
+Copyright (c) 2019 James Boer
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Parameters describing a synthetic table
+struct GeneratorOptions
+{
+	size_t rows = 1000;
+	size_t columns = 8;
+
+	// Fraction of data columns holding numbers rather than text
+	double numericFraction = 0.5;
+
+	// Fraction of text cells enclosed in double-quotes, some of which contain escaped quotes
+	double quoteDensity = 0.0;
+
+	// Use semicolon delimiters and comma decimal separators
+	bool continental = false;
+
+	uint64_t seed = 1;
+};
+
+// Generates CSV text with a header row and a unique name in the first column of each row.  Data
+// columns alternate between integers and doubles for numeric columns, or hold text otherwise.
+std::string GenerateTable(const GeneratorOptions & options);
+
+// Returns the name of a generated row or column
+std::string GetRowName(size_t row);
+std::string GetColumnName(size_t column);
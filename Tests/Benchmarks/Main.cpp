@@ -0,0 +1,204 @@
+/*
+The Tbl library is distributed under the MIT License (MIT)
+https://opensource.org/licenses/MIT
+See the LICENSE file or Tbl.hpp for license details.
+Copyright (c) 2019 James Boer
+*/
+
+#include "../../Include/Tbl.hpp"
+#include "Benchmark.h"
+#include "Generator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using Table = Tbl::Table<CountingAllocator<char>>;
+using TableView = Tbl::TableView<CountingAllocator<char>>;
+using ArenaTable = Tbl::Table<Tbl::ArenaAllocator<char>>;
+
+namespace
+{
+	struct Scenario
+	{
+		const char * name;
+		GeneratorOptions options;
+	};
+
+	struct Result
+	{
+		std::string scenario;
+		std::string benchmark;
+		double value;
+		const char * unit;
+	};
+
+	const size_t LookupCount = 1000000;
+
+	// Prevents the compiler from discarding benchmarked work
+	volatile uint64_t sink = 0;
+
+	GeneratorOptions MakeOptions(size_t rows, size_t columns, double numericFraction, double quoteDensity, bool continental)
+	{
+		GeneratorOptions options;
+		options.rows = rows;
+		options.columns = columns;
+		options.numericFraction = numericFraction;
+		options.quoteDensity = quoteDensity;
+		options.continental = continental;
+		return options;
+	}
+
+	template<typename TableType>
+	void BenchmarkConstruction(const Scenario & scenario, const std::string & text, const char * name, size_t threads, double minSeconds, std::vector<Result> & results, bool countMemory = true)
+	{
+		Tbl::Options options;
+		options.threads = threads;
+		const double seconds = MeasureBest([&]
+		{
+			TableType table(text, options);
+			sink = sink + table.GetNumRows();
+		}, 3, minSeconds);
+		const double megabytes = text.size() / (1024.0 * 1024.0);
+		results.push_back({ scenario.name, std::string(name) + " construction", megabytes / seconds, "MB/s" });
+
+		// Memory is only counted for tables using CountingAllocator
+		if (!countMemory)
+			return;
+		const size_t baseline = MemoryCounter::ResetPeak();
+		{
+			TableType table(text, options);
+			sink = sink + table.GetNumRows();
+		}
+		results.push_back({ scenario.name, std::string(name) + " peak memory", (MemoryCounter::peak - baseline) / (1024.0 * 1024.0), "MB" });
+	}
+
+	template<typename T>
+	uint64_t ToSinkValue(const T & value)
+	{
+		if constexpr (std::is_arithmetic_v<T>)
+			return static_cast<uint64_t>(value);
+		else
+			return value.size();
+	}
+
+	template<typename T>
+	void BenchmarkGet(const Scenario & scenario, const Table & table, size_t column, double minSeconds, std::vector<Result> & results)
+	{
+		std::mt19937_64 rng(scenario.options.seed);
+		std::vector<size_t> rows(LookupCount);
+		for (auto & row : rows)
+			row = rng() % table.GetNumRows();
+
+		double seconds = MeasureBest([&]
+		{
+			uint64_t sum = 0;
+			for (size_t row : rows)
+				sum += ToSinkValue(table.Get<T>(row, column));
+			sink = sink + sum;
+		}, 3, minSeconds);
+		results.push_back({ scenario.name, "Get by index", seconds * 1e9 / rows.size(), "ns/op" });
+
+		std::vector<std::string> rowNames;
+		rowNames.reserve(rows.size());
+		for (size_t row : rows)
+			rowNames.push_back(GetRowName(row));
+		const std::string columnName = GetColumnName(column);
+		seconds = MeasureBest([&]
+		{
+			uint64_t sum = 0;
+			for (const auto & rowName : rowNames)
+				sum += ToSinkValue(table.Get<T>(rowName, columnName));
+			sink = sink + sum;
+		}, 3, minSeconds);
+		results.push_back({ scenario.name, "Get by name", seconds * 1e9 / rowNames.size(), "ns/op" });
+	}
+
+	void BenchmarkSum(const Scenario & scenario, const Table & table, double minSeconds, std::vector<Result> & results)
+	{
+		size_t cells = 0;
+		const double seconds = MeasureBest([&]
+		{
+			double sum = 0.0;
+			cells = 0;
+			for (size_t column = 1; column < table.GetNumColumns(); ++column)
+			{
+				sum += table.Sum(column);
+				cells += table.GetNumRows();
+			}
+			sink = sink + static_cast<uint64_t>(sum);
+		}, 3, minSeconds);
+		results.push_back({ scenario.name, "Column sum", seconds * 1e9 / std::max<size_t>(cells, 1), "ns/cell" });
+	}
+
+	void RunScenario(const Scenario & scenario, double minSeconds, std::vector<Result> & results)
+	{
+		const std::string text = GenerateTable(scenario.options);
+		results.push_back({ scenario.name, "Text size", text.size() / (1024.0 * 1024.0), "MB" });
+		BenchmarkConstruction<Table>(scenario, text, "Table", 1, minSeconds, results);
+		BenchmarkConstruction<TableView>(scenario, text, "TableView", 1, minSeconds, results);
+		BenchmarkConstruction<Table>(scenario, text, "Table parallel", 0, minSeconds, results);
+		BenchmarkConstruction<ArenaTable>(scenario, text, "Table arena", 1, minSeconds, results, false);
+
+		// Benchmark lookups of the first data column
+		const Table table(text);
+		const size_t column = 1;
+		switch (table.GetColumnType(column))
+		{
+			case Tbl::ColumnType::Integer: BenchmarkGet<int64_t>(scenario, table, column, minSeconds, results); break;
+			case Tbl::ColumnType::Double: BenchmarkGet<double>(scenario, table, column, minSeconds, results); break;
+			case Tbl::ColumnType::String: BenchmarkGet<Table::String>(scenario, table, column, minSeconds, results); break;
+			default: break;
+		}
+		BenchmarkSum(scenario, table, minSeconds, results);
+	}
+}
+
+// Usage: Benchmarks [--quick] [results.csv]
+// Results are printed, and written as CSV for comparison between releases.
+int main(int argc, char ** argv)
+{
+	bool quick = false;
+	const char * outputPath = "BenchmarkResults.csv";
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--quick") == 0)
+			quick = true;
+		else
+			outputPath = argv[i];
+	}
+	const size_t rows = quick ? 20000 : 200000;
+	const double minSeconds = quick ? 0.05 : 0.5;
+
+	const Scenario scenarios[] =
+	{
+		{ "Numeric", MakeOptions(rows, 8, 1.0, 0.0, false) },
+		{ "Text", MakeOptions(rows, 8, 0.0, 0.0, false) },
+		{ "Mixed", MakeOptions(rows, 8, 0.5, 0.0, false) },
+		{ "Quoted", MakeOptions(rows, 8, 0.25, 0.5, false) },
+		{ "Wide", MakeOptions(rows / 20, 160, 0.5, 0.1, false) },
+		{ "Continental", MakeOptions(rows, 8, 0.5, 0.1, true) },
+	};
+
+	std::vector<Result> results;
+	for (const auto & scenario : scenarios)
+	{
+		const size_t first = results.size();
+		RunScenario(scenario, minSeconds, results);
+		for (size_t i = first; i < results.size(); ++i)
+			std::printf("%-12s %-32s %12.2f %s\n", results[i].scenario.c_str(), results[i].benchmark.c_str(), results[i].value, results[i].unit);
+	}
+
+	std::ofstream output(outputPath);
+	if (!output)
+	{
+		std::fprintf(stderr, "Unable to write %s\n", outputPath);
+		return 1;
+	}
+	output << "Scenario,Benchmark,Value,Unit\n";
+	for (const auto & result : results)
+		output << result.scenario << ',' << result.benchmark << ',' << result.value << ',' << result.unit << '\n';
+	return 0;
+}
@@ -7,6 +7,13 @@ Copyright (c) 2019 James Boer
 
 #include "UnitTest.h"
 #include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 
 using namespace Tbl;
 using String = Tbl::Table<>::String;
@@ -249,6 +256,34 @@ TEST_CASE("Test Tables", "[Tables]")
 		REQUIRE(t.Get<String>("Test Name C", "Text Field") == "Try \"A, B, C\" for fun!");
 	}
 
+	SECTION("Comma-Delimited Table Test From Mapped File 2")
+	{
+		auto t = Table<>::FromFile(GetTestDataPath("Test2.csv"));
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 2);
+		REQUIRE(t.GetNumRows() == 3);
+		REQUIRE(t.Get<String>("Test Name A", "Text Field") == "Test 1, Test 2, Test 3");
+		REQUIRE(t.Get<String>("Test Name B", "Text Field") == "\"Quoted text\"");
+		REQUIRE(t.Get<String>("Test Name C", "Text Field") == "Try \"A, B, C\" for fun!");
+	}
+
+	SECTION("Tab-Delimited Table View Test From Mapped File 2")
+	{
+		auto t = TableView<>::FromFile(GetTestDataPath("Test2.txt"));
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 2);
+		REQUIRE(t.GetNumRows() == 3);
+		REQUIRE(t.Get<std::string_view>("Test Name A", "Text Field") == "Test 1, Test 2, Test 3");
+		REQUIRE(t.Get<std::string_view>("Test Name B", "Text Field") == "\"Quoted text\"");
+		REQUIRE(t.Get<std::string_view>("Test Name C", "Text Field") == "Try \"A, B, C\" for fun!");
+	}
+
+	SECTION("Table Test From Missing File")
+	{
+		auto t = Table<>::FromFile(GetTestDataPath("Missing.csv"));
+		REQUIRE(!t);
+	}
+
 	SECTION("Semicolon-Delimited Table Test From File 3")
 	{
 		auto tableText = LoadTestData("Test3.csv");
@@ -299,4 +334,1142 @@ TEST_CASE("Test Tables", "[Tables]")
 		REQUIRE(v3.index() == StringType);
 	}
 
+	SECTION("Comma-Delimited Table Test Spanning Scanner Blocks")
+	{
+		std::string tableText = "Name Field,Integer Field,Text Field\r\n";
+		for (int i = 0; i < 200; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i * 3) + ",";
+			tableText += "\"Text, with \"\"quotes\"\" and\nnewlines " + std::string(i % 70, 'x') + "\"\r\n";
+		}
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 3);
+		REQUIRE(t.GetNumRows() == 200);
+		for (int i = 0; i < 200; ++i)
+		{
+			auto rowName = "Row " + std::to_string(i);
+			REQUIRE(t.Get<int64_t>(rowName.c_str(), "Integer Field") == i * 3);
+			REQUIRE(t.Get<String>(rowName.c_str(), "Text Field") == "Text, with \"quotes\" and\nnewlines " + std::string(i % 70, 'x'));
+		}
+	}
+
+	SECTION("Comma-Delimited Table Test Parsed In Parallel")
+	{
+		std::string tableText = "Name Field,Integer Field,Float Field,Text Field\n";
+		for (int i = 0; i < 20000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i) + ".5,";
+			if (i % 3 == 0)
+				tableText += "\"Quoted, multi-line\n\"\"text\"\"\"\n";
+			else if (i % 1000 == 1)
+				tableText += "A 5\" unquoted quote\n";
+			else
+				tableText += "Plain text\n";
+		}
+
+		Options options;
+		options.threads = 4;
+		Table t(tableText, options);
+		Table s(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 4);
+		REQUIRE(t.GetNumRows() == 20000);
+		bool matches = true;
+		for (size_t row = 0; row < t.GetNumRows(); ++row)
+		{
+			for (size_t column = 0; column < t.GetNumColumns(); ++column)
+				matches = matches && t.GetData(row, column) == s.GetData(row, column);
+		}
+		REQUIRE(matches);
+		REQUIRE(t.Get<int64_t>("Row 19999", "Integer Field") == 19999);
+		REQUIRE(t.Get<String>("Row 3", "Text Field") == "Quoted, multi-line\n\"text\"");
+		REQUIRE(t.Get<String>("Row 1001", "Text Field") == "A 5\" unquoted quote");
+	}
+
+	SECTION("Comma-Delimited Table View Test")
+	{
+		static const std::string tableText =
+			"Name Field,Integer Field,Text Field\n"
+			"Test Name A,1,This is a simple test.\n"
+			"Test Name B,2,\"Test 1, 2, 3\"\n"
+			"Test Name C,3,\"\"\"Quoted text\"\"\"\n"
+			;
+
+		TableView<> t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 3);
+		REQUIRE(t.GetNumRows() == 3);
+		REQUIRE(t.Get<std::string_view>(0, 0) == "Test Name A");
+		REQUIRE(t.Get<int64_t>("Test Name B", "Integer Field") == 2);
+		REQUIRE(t.Get<std::string_view>("Test Name A", "Text Field") == "This is a simple test.");
+		REQUIRE(t.Get<std::string_view>("Test Name B", "Text Field") == "Test 1, 2, 3");
+		REQUIRE(t.Get<std::string_view>("Test Name C", "Text Field") == "\"Quoted text\"");
+		REQUIRE(t.GetData(0, 2).index() == StringType);
+
+		// Unescaped cells refer directly to the source text, while escaped cells are copied
+		auto inSource = [&](std::string_view str)
+		{
+			return str.data() >= tableText.data() && str.data() < tableText.data() + tableText.size();
+		};
+		REQUIRE(inSource(t.Get<std::string_view>("Test Name A", "Text Field")));
+		REQUIRE(inSource(t.Get<std::string_view>("Test Name B", "Text Field")));
+		REQUIRE(!inSource(t.Get<std::string_view>("Test Name C", "Text Field")));
+
+		// Copies share the escaped string storage
+		TableView<> c = t;
+		REQUIRE(c.Get<std::string_view>("Test Name C", "Text Field") == "\"Quoted text\"");
+	}
+
+	SECTION("Comma-Delimited Table Test Using Column Types")
+	{
+		static const char * tableText =
+			"Name Field,Integer Field,Float Field,Text Field,Mixed Field\n"
+			"Test Name A,1,4.5,This is a simple test.,1\n"
+			"Test Name B,2,123.456,More to test...,2.5\n"
+			"Test Name C,3,22.3345,Even more tests of text,Text\n"
+			;
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetColumnType(0) == ColumnType::String);
+		REQUIRE(t.GetColumnType(1) == ColumnType::Integer);
+		REQUIRE(t.GetColumnType(2) == ColumnType::Double);
+		REQUIRE(t.GetColumnType(3) == ColumnType::String);
+		REQUIRE(t.GetColumnType(4) == ColumnType::Mixed);
+
+		auto integers = t.GetColumn<int64_t>("Integer Field");
+		REQUIRE(integers.size() == 3);
+		REQUIRE(integers[0] == 1);
+		REQUIRE(integers[2] == 3);
+		auto doubles = t.GetColumn<double>("Float Field");
+		REQUIRE(doubles.size() == 3);
+		REQUIRE(doubles[1] == Approx(123.456));
+		REQUIRE(t.GetColumn<double>("Integer Field").empty());
+		REQUIRE(t.GetColumn<int64_t>("Mixed Field").empty());
+
+		REQUIRE(t.Get<int64_t>("Test Name A", "Mixed Field") == 1);
+		REQUIRE(t.Get<double>("Test Name B", "Mixed Field") == Approx(2.5));
+		REQUIRE(t.Get<String>("Test Name C", "Mixed Field") == "Text");
+		REQUIRE(t.GetData(0, 4).index() == IntType);
+		REQUIRE(t.GetData(1, 4).index() == DoubleType);
+		REQUIRE(t.GetData(2, 4).index() == StringType);
+		REQUIRE_THROWS_AS(t.Get<double>("Test Name A", "Integer Field"), std::bad_variant_access);
+		REQUIRE_THROWS_AS(t.Get<String>("Test Name A", "Mixed Field"), std::bad_variant_access);
+	}
+
+	SECTION("Comma-Delimited Table Snapshot Test")
+	{
+		static const char * tableText =
+			"Name Field,Integer Field,Float Field,Text Field,Mixed Field\n"
+			"Test Name A,1,4.5,This is a simple test.,1\n"
+			"Test Name B,2,123.456,\"Test 1, 2, 3\",2.5\n"
+			"Test Name C,3,22.3345,\"\"\"Quoted text\"\"\",Text\n"
+			;
+
+		Table t(tableText);
+		REQUIRE(t);
+		auto snapshot = t.ToSnapshot();
+
+		auto matches = [&](const auto & other)
+		{
+			if (other.GetNumColumns() != t.GetNumColumns() || other.GetNumRows() != t.GetNumRows())
+				return false;
+			for (size_t row = 0; row < t.GetNumRows(); ++row)
+			{
+				for (size_t column = 0; column < t.GetNumColumns(); ++column)
+				{
+					auto a = t.GetData(row, column);
+					auto b = other.GetData(row, column);
+					if (a.index() != b.index() || t.GetColumnType(column) != other.GetColumnType(column))
+						return false;
+					if (a.index() == IntType && std::get<int64_t>(a) != std::get<int64_t>(b))
+						return false;
+					if (a.index() == DoubleType && std::get<double>(a) != std::get<double>(b))
+						return false;
+					if (a.index() == StringType && std::string_view(std::get<String>(a)) != std::string_view(std::get<StringType>(b)))
+						return false;
+				}
+			}
+			return true;
+		};
+
+		auto s = Table<>::FromSnapshot(snapshot);
+		REQUIRE(s);
+		REQUIRE(matches(s));
+		REQUIRE(s.Get<String>("Test Name C", "Text Field") == "\"Quoted text\"");
+
+		auto v = TableView<>::FromSnapshot(snapshot);
+		REQUIRE(v);
+		REQUIRE(matches(v));
+		REQUIRE(v.Get<std::string_view>("Test Name B", "Text Field") == "Test 1, 2, 3");
+
+		// Snapshots can also be memory-mapped from a file
+		{
+			std::ofstream file("Snapshot.tbls", std::ios::binary);
+			file.write(snapshot.data(), snapshot.size());
+		}
+		{
+			auto f = TableView<>::FromSnapshotFile("Snapshot.tbls");
+			REQUIRE(f);
+			REQUIRE(matches(f));
+			auto o = Table<>::FromSnapshotFile("Snapshot.tbls");
+			REQUIRE(o);
+			REQUIRE(matches(o));
+			REQUIRE(o.Get<int64_t>("Test Name C", "Integer Field") == 3);
+		}
+		std::remove("Snapshot.tbls");
+
+		// Corrupt or truncated snapshots are rejected
+		auto corrupt = snapshot;
+		corrupt[corrupt.size() / 2] ^= 1;
+		REQUIRE(!Table<>::FromSnapshot(corrupt));
+		REQUIRE(!Table<>::FromSnapshot(std::string_view(snapshot).substr(0, snapshot.size() - 1)));
+		REQUIRE(!Table<>::FromSnapshot(std::string_view(snapshot).substr(0, 16)));
+
+		// A row map that doesn't match the row names is rejected, even with a valid checksum.  The
+		// two tables differ only in their row maps and string pools, which are the same size.
+		auto mismatched = Table<>("Name,V\nA,1\nB,2\n").ToSnapshot();
+		const auto repeated = Table<>("Name,V\nA,1\nA,2\n").ToSnapshot();
+		REQUIRE(Table<>::FromSnapshot(mismatched));
+		REQUIRE(Table<>::FromSnapshot(repeated));
+		Tbl::Detail::SnapshotHeader header;
+		std::memcpy(&header, mismatched.data(), sizeof(header));
+		mismatched.replace(static_cast<size_t>(header.poolOffset), std::string::npos, repeated, repeated.size() - static_cast<size_t>(header.poolSize), std::string::npos);
+		header.checksum = Tbl::Detail::Checksum(mismatched.data() + sizeof(header), mismatched.size() - sizeof(header));
+		std::memcpy(&mismatched[0], &header, sizeof(header));
+		REQUIRE(!Table<>::FromSnapshot(mismatched));
+	}
+
+	SECTION("Comma-Delimited Table Test Using String View Lookups")
+	{
+		static const char * tableText =
+			"Name Field,Integer Field,Float Field,Text Field\n"
+			"Test Name A,1,4.5,This is a simple test.\n"
+			"Test Name B,2,123.456,More to test...\n"
+			;
+
+		auto original = std::make_unique<Table<>>(tableText);
+		REQUIRE(*original);
+		const std::string_view rowName = "Test Name B";
+		const std::string columnName = "Integer Field";
+		REQUIRE(original->GetRowIndex(rowName) == 1);
+		REQUIRE(original->GetColumnIndex(columnName) == 1);
+		REQUIRE(original->Get<int64_t>(rowName, columnName) == 2);
+		REQUIRE(original->Get<double>(String("Test Name A"), std::string_view("Float Field")) == Approx(4.5));
+
+		// Copied tables use their own copies of row and column names
+		Table<> copy = *original;
+		original.reset();
+		REQUIRE(copy.Get<int64_t>(rowName, columnName) == 2);
+		REQUIRE(copy.Get<String>("Test Name A", "Text Field") == "This is a simple test.");
+	}
+
+	SECTION("Comma-Delimited Table Test Using Many Row Names")
+	{
+		std::string tableText = "Name,Index\n";
+		const int rowCount = 10000;
+		const int repeatRow = rowCount / 2;
+		for (int i = 0; i < rowCount; ++i)
+		{
+			// A repeated name in the middle of the table
+			if (i == repeatRow)
+				tableText += "Row 5,-1\n";
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i) + "\n";
+		}
+
+		Table<> table(tableText);
+		REQUIRE(table);
+		REQUIRE(table.GetNumRows() == rowCount + 1);
+		for (int i = 0; i < rowCount; ++i)
+		{
+			const std::string rowName = "Row " + std::to_string(i);
+			REQUIRE(table.GetRowIndex(rowName) == size_t(i < repeatRow ? i : i + 1));
+			REQUIRE(table.Get<int64_t>(rowName, "Index") == i);
+		}
+		REQUIRE(table.Get<int64_t>(size_t(repeatRow), 1) == -1);
+		REQUIRE(table.GetColumnIndex("Name") == 0);
+		REQUIRE(table.GetColumnIndex("Index") == 1);
+
+		auto snapshot = Table<>::FromSnapshot(table.ToSnapshot());
+		REQUIRE(snapshot);
+		REQUIRE(snapshot.GetNumRows() == rowCount + 1);
+		REQUIRE(snapshot.Get<int64_t>("Row 9999", "Index") == 9999);
+		REQUIRE(snapshot.Get<int64_t>("Row 5", "Index") == 5);
+
+		Table<> small("Name,V\nA,1\nB,2\nA,3\nC,4\nD,5\n");
+		REQUIRE(small);
+		REQUIRE(small.GetNumRows() == 5);
+		REQUIRE(small.Get<int64_t>("A", "V") == 1);
+		REQUIRE(small.Get<int64_t>("C", "V") == 4);
+		REQUIRE(small.Get<int64_t>("D", "V") == 5);
+		REQUIRE(small.Get<int64_t>(size_t(2), 1) == 3);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Compile-Time Names")
+	{
+		static const char * tableText =
+			"Name Field,Integer Field,Float Field,Text Field\n"
+			"Test Name A,1,4.5,This is a simple test.\n"
+			"Test Name B,2,123.456,More to test...\n"
+			;
+
+		static constexpr Tbl::Name integerField = "Integer Field";
+		static constexpr Tbl::Name floatField = "Float Field";
+		static_assert(integerField.GetHash() == Tbl::Detail::HashString("Integer Field"), "Name hash should be computed at compile time");
+
+		Table<> table(tableText);
+		REQUIRE(table);
+		REQUIRE(table.GetColumnIndex(integerField) == 1);
+		REQUIRE(table.Get<int64_t>("Test Name B", integerField) == 2);
+		REQUIRE(table.Get<double>(std::string("Test Name A"), floatField) == Approx(4.5));
+		REQUIRE(std::get<int64_t>(table.GetData("Test Name A", integerField)) == 1);
+		REQUIRE(table.GetColumn<int64_t>(integerField).size() == 2);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Exact Doubles")
+	{
+		static const char * tableText =
+			"Name,Value\n"
+			"A,0.1\n"
+			"B,-3.14159\n"
+			"C,+2.5\n"
+			"D, 4.5 \n"
+			"E,1e-300\n"
+			"F,2.2250738585072014e-308\n"
+			"G,123456789012345678901234.5\n"
+			"H,0.000000000000000000000000000123\n"
+			"J,.5e3\n"
+			"K,12abc\n"
+			"L,1e\n"
+			"M,-\n"
+			;
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.Get<double>("A", "Value") == 0.1);
+		REQUIRE(t.Get<double>("B", "Value") == -3.14159);
+		REQUIRE(t.Get<double>("C", "Value") == 2.5);
+		REQUIRE(t.Get<double>("D", "Value") == 4.5);
+		REQUIRE(t.Get<double>("E", "Value") == 1e-300);
+		REQUIRE(t.Get<double>("F", "Value") == 2.2250738585072014e-308);
+		REQUIRE(t.Get<double>("G", "Value") == 123456789012345678901234.5);
+		REQUIRE(t.Get<double>("H", "Value") == 0.000000000000000000000000000123);
+		REQUIRE(t.Get<double>("J", "Value") == 500.0);
+		REQUIRE(t.Get<String>("K", "Value") == "12abc");
+		REQUIRE(t.Get<String>("L", "Value") == "1e");
+		REQUIRE(t.Get<String>("M", "Value") == "-");
+
+		static const char * continentalText =
+			"Name;Value\n"
+			"A;0,1\n"
+			"B;-1234,5678e-3\n"
+			"C;2.5\n"
+			;
+		Table c(continentalText);
+		REQUIRE(c);
+		REQUIRE(c.Get<double>("A", "Value") == 0.1);
+		REQUIRE(c.Get<double>("B", "Value") == -1.2345678);
+		REQUIRE(c.Get<double>("C", "Value") == 2.5);
+
+		// Compare against strtod across fast and slow path inputs
+		uint64_t seed = 1;
+		auto random = [&seed]() { seed = seed * 6364136223846793005ull + 1442695040888963407ull; return seed >> 33; };
+		for (int i = 0; i < 10000; ++i)
+		{
+			std::string number = std::to_string(random() % 100000000) + std::to_string(random());
+			number = number.substr(0, 1 + random() % number.size());
+			number.insert(random() % (number.size() + 1), ".");
+			number += "e" + std::to_string(static_cast<int>(random() % 80) - 40);
+			double value = 0.0;
+			REQUIRE(Tbl::Detail::ParseDouble(number, '.', value));
+			REQUIRE(value == std::strtod(number.c_str(), nullptr));
+		}
+
+		// Numbers halfway between two doubles, or too close to halfway to decide from their first
+		// 19 digits, are still rounded correctly
+		static const char * hardNumbers[] =
+		{
+			"9007199254740993.0",
+			"1.00000000000000011102230246251565404236316680908203125",
+			"1.00000000000000011102230246251565404236316680908203124",
+			"1.000000000000000111022302462515654042363166809082031250000000000000000000000000001",
+			"2.4703282292062328e-324",
+			"2.2250738585072011e-308",
+			"1.7976931348623157e308",
+			"7.2057594037927933e16",
+		};
+		for (const char * number : hardNumbers)
+		{
+			double value = 0.0;
+			REQUIRE(Tbl::Detail::ParseDouble(number, '.', value));
+			REQUIRE(value == std::strtod(number, nullptr));
+			std::string continental = number;
+			std::replace(continental.begin(), continental.end(), '.', ',');
+			double continentalValue = 0.0;
+			REQUIRE(Tbl::Detail::ParseDouble(continental, ',', continentalValue));
+			REQUIRE(continentalValue == value);
+		}
+		double outOfRange = 0.0;
+		REQUIRE(!Tbl::Detail::ParseDouble("1e400", '.', outOfRange));
+		REQUIRE(!Tbl::Detail::ParseDouble("1e-400", '.', outOfRange));
+
+		// Doubles are formatted as the shortest text that parses back to the same value
+		REQUIRE(Tbl::Detail::FormatDouble(0.1) == "0.1");
+		REQUIRE(Tbl::Detail::FormatDouble(-2.5) == "-2.5");
+		REQUIRE(Tbl::Detail::FormatDouble(1.0 / 3.0) == "0.3333333333333333");
+		REQUIRE(Tbl::Detail::FormatDouble(1e22) == "1e+22");
+		REQUIRE(Tbl::Detail::FormatDouble(1.5e-7) == "1.5e-07");
+		REQUIRE(Tbl::Detail::FormatDouble(123456789012345678.0) == "123456789012345680");
+		REQUIRE(Tbl::Detail::FormatDouble(5e-324) == "5e-324");
+		for (const char * number : hardNumbers)
+		{
+			double value = 0.0, formatted = 0.0;
+			REQUIRE(Tbl::Detail::ParseDouble(number, '.', value));
+			REQUIRE(Tbl::Detail::ParseDouble(Tbl::Detail::FormatDouble(value), '.', formatted));
+			REQUIRE(formatted == value);
+		}
+	}
+
+	SECTION("Comma-Delimited Table Test Classifying Cells")
+	{
+		static const char * tableText =
+			"Name,Value\n"
+			"A,42\n"
+			"B,-9223372036854775808\n"
+			"C,9223372036854775808\n"
+			"D,+17\n"
+			"E, 7\n"
+			"F,7 \n"
+			"G,1.0\n"
+			"H,1e3\n"
+			"J,\n"
+			"K,123 Main St\n"
+			"L,-x\n"
+			;
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.Get<int64_t>("A", "Value") == 42);
+		REQUIRE(t.Get<int64_t>("B", "Value") == INT64_MIN);
+		REQUIRE(t.Get<double>("C", "Value") == 9223372036854775808.0);
+		REQUIRE(t.Get<int64_t>("D", "Value") == 17);
+		REQUIRE(t.Get<int64_t>("E", "Value") == 7);
+		REQUIRE(t.Get<double>("F", "Value") == 7.0);
+		REQUIRE(t.Get<double>("G", "Value") == 1.0);
+		REQUIRE(t.Get<double>("H", "Value") == 1000.0);
+		REQUIRE(t.Get<int64_t>("J", "Value") == 0);
+		REQUIRE(t.Get<String>("K", "Value") == "123 Main St");
+		REQUIRE(t.Get<String>("L", "Value") == "-x");
+	}
+
+	SECTION("Comma-Delimited Streaming Reader Test")
+	{
+		static const char * tableText =
+			"Name Field,Integer Field,Float Field,Text Field\r\n"
+			"Row 1,1,4.5,\"Quoted, text\"\r\n"
+			"Row 2,2,123.456,\"Quoted, multi-line\n\"\"text\"\"\"\r\n"
+			"\r\n"
+			"Row 3,3,22.3345,Plain text"
+			;
+
+		// Feed the text in chunks of every size, so cells and line ends are split at every position
+		const std::string_view text = tableText;
+		for (size_t chunkSize = 1; chunkSize <= text.size(); ++chunkSize)
+		{
+			std::vector<std::string> names;
+			int64_t intTotal = 0;
+			double doubleTotal = 0.0;
+			std::string texts;
+			Reader<> reader([&](const Reader<>::Row & row)
+			{
+				REQUIRE(row.GetNumColumns() == 4);
+				names.emplace_back(row.GetText(0));
+				intTotal += row.Get<int64_t>(1);
+				doubleTotal += row.Get<double>(2);
+				texts += row.Get<std::string_view>(3);
+				texts += '|';
+			});
+			for (size_t pos = 0; pos < text.size(); pos += chunkSize)
+				reader.Write(text.substr(pos, chunkSize));
+			REQUIRE(reader.Finish());
+			REQUIRE(reader.GetNumColumns() == 4);
+			REQUIRE(reader.GetColumnIndex("Text Field") == 3);
+			REQUIRE(names == std::vector<std::string>{ "Row 1", "Row 2", "Row 3" });
+			REQUIRE(intTotal == 6);
+			REQUIRE(doubleTotal == Approx(4.5 + 123.456 + 22.3345));
+			REQUIRE(texts == "Quoted, text|Quoted, multi-line\n\"text\"|Plain text|");
+		}
+
+		Reader<> bad([](const Reader<>::Row &) {});
+		bad.Write("A,B\n1,2\n3\n");
+		REQUIRE(!bad);
+		REQUIRE(!bad.Finish());
+
+		// A long row written in small chunks is scanned as each chunk arrives, and only parsed
+		// once complete
+		std::string quotedCell, cellText;
+		for (int i = 0; i < 20000; ++i)
+		{
+			quotedCell += i % 100 == 0 ? "\"\"," : "text\r\n";
+			cellText += i % 100 == 0 ? "\"," : "text\r\n";
+		}
+		const std::string longText = "Name,Quoted,Unquoted\nRow 1,\"" + quotedCell + "\",A 5\" quote\r\nRow 2,x,y\n";
+		std::vector<std::string> cells;
+		Reader<> longReader([&](const Reader<>::Row & row)
+		{
+			for (size_t column = 0; column < row.GetNumColumns(); ++column)
+				cells.emplace_back(row.GetText(column));
+		});
+		for (size_t pos = 0; pos < longText.size(); pos += 3)
+			longReader.Write(std::string_view(longText).substr(pos, 3));
+		REQUIRE(longReader.Finish());
+		REQUIRE(cells == std::vector<std::string>{ "Row 1", cellText, "A 5\" quote", "Row 2", "x", "y" });
+	}
+
+	SECTION("Comma-Delimited Table Test Using Column Projection")
+	{
+		std::string tableText = "Name Field,Integer Field,Float Field,Text Field\n";
+		for (int i = 0; i < 20000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i) + ".5,";
+			tableText += (i % 3 == 0) ? "\"Quoted, multi-line\n\"\"text\"\"\"\n" : "Plain text\n";
+		}
+
+		Options options;
+		options.columns = { "Float Field" };
+		Table t(tableText, options);
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 2);
+		REQUIRE(t.GetNumRows() == 20000);
+		REQUIRE(t.GetColumnIndex("Float Field") == 1);
+		REQUIRE(t.GetColumnType(1) == ColumnType::Double);
+		REQUIRE(t.Get<double>("Row 19999", "Float Field") == 19999.5);
+
+		options.threads = 4;
+		options.columns = { "Text Field", "Integer Field" };
+		Table p(tableText, options);
+		REQUIRE(p);
+		REQUIRE(p.GetNumColumns() == 3);
+		REQUIRE(p.GetColumnIndex("Integer Field") == 1);
+		REQUIRE(p.GetColumnIndex("Text Field") == 2);
+		REQUIRE(p.Get<int64_t>("Row 19999", "Integer Field") == 19999);
+		REQUIRE(p.Get<String>("Row 3", "Text Field") == "Quoted, multi-line\n\"text\"");
+
+		options.columns = { "Missing Field" };
+		Table m(tableText, options);
+		REQUIRE(!m);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Row Filter")
+	{
+		std::string tableText = "Name Field,Region,Integer Field,Text Field\n";
+		for (int i = 0; i < 20000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + (i % 20 == 0 ? "EU" : "\"US\"") + "," + std::to_string(i) + ",";
+			tableText += (i % 3 == 0) ? "\"Quoted, multi-line\n\"\"text\"\"\"\n" : "A 5\" unquoted quote\n";
+		}
+
+		Options options;
+		options.columns = { "Integer Field", "Text Field" };
+		options.filterColumns = { "Region" };
+		options.filter = [](const RowView & row) { return row.Get<std::string_view>(0) == "EU"; };
+		Table t(tableText, options);
+		REQUIRE(t);
+		REQUIRE(t.GetNumColumns() == 3);
+		REQUIRE(t.GetNumRows() == 1000);
+		REQUIRE(t.Get<int64_t>("Row 19980", "Integer Field") == 19980);
+		REQUIRE(t.Get<String>("Row 60", "Text Field") == "Quoted, multi-line\n\"text\"");
+		REQUIRE(t.Get<String>("Row 20", "Text Field") == "A 5\" unquoted quote");
+
+		// Filter on the row name and a numeric column that comes after it, in parallel
+		options.threads = 4;
+		options.columns.clear();
+		options.filterColumns = { "Integer Field", "Name Field" };
+		options.filter = [](const RowView & row) { return row.Get<int64_t>(0) < 100 && row.Get<std::string_view>(1) != "Row 7"; };
+		Table p(tableText, options);
+		REQUIRE(p);
+		REQUIRE(p.GetNumColumns() == 4);
+		REQUIRE(p.GetNumRows() == 99);
+		REQUIRE(p.Get<String>("Row 40", "Region") == "EU");
+		REQUIRE(p.Get<String>("Row 41", "Region") == "US");
+
+		options.filterColumns = { "Missing Field" };
+		Table m(tableText, options);
+		REQUIRE(!m);
+
+		// Parallel chunks may start at a false row boundary, where quoted line ends and stray
+		// quotes are misread, but the filter is only ever called for real rows
+		std::string quotedText = "Name Field,Id,Text Field\n";
+		uint64_t seed = 1;
+		for (int i = 0; i < 30000; ++i)
+		{
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+			quotedText += "Row " + std::to_string(i) + "," + std::to_string(i) + ",";
+			static const char * texts[] = { "\"Multi\nline, \"\"quoted\"\"\nRow x,abc,def\"\n", "A 5\" stray quote\n", "Two \"\" stray\n", "Plain\n" };
+			quotedText += texts[(seed >> 33) % 4];
+		}
+		options.threads = 8;
+		options.filterColumns = { "Id" };
+		options.filter = [](const RowView & row) { return row.Get<int64_t>(0) % 2 == 0; };
+		Table q(quotedText, options);
+		REQUIRE(q);
+		REQUIRE(q.GetNumRows() == 15000);
+		REQUIRE(q.Get<String>("Row 29998", "Text Field").size() > 0);
+
+		// Exceptions thrown by the filter on any thread are passed on to the caller
+		options.filter = [](const RowView & row)
+		{
+			if (row.Get<int64_t>(0) == 20000)
+				throw std::runtime_error("Filter error");
+			return true;
+		};
+		REQUIRE_THROWS_AS(Table(quotedText, options), std::runtime_error);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Arena Allocator")
+	{
+		std::string tableText = "Name Field,Integer Field,Float Field,Text Field\n";
+		for (int i = 0; i < 20000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i) + ".5,";
+			tableText += (i % 3 == 0) ? "\"Quoted, multi-line\n\"\"text\"\"\"\n" : "Some longer text that won't fit in a small string\n";
+		}
+
+		using ArenaTable = Table<ArenaAllocator<char>>;
+		using ArenaString = ArenaTable::String;
+		Options options;
+		options.threads = 4;
+		ArenaTable s(tableText);
+		ArenaTable t(tableText, options);
+		REQUIRE(s);
+		REQUIRE(t);
+		REQUIRE(t.GetNumRows() == 20000);
+		REQUIRE(t.Get<ArenaString>("Row 3", "Text Field") == "Quoted, multi-line\n\"text\"");
+		REQUIRE(t.Get<ArenaString>("Row 19999", "Text Field") == "Some longer text that won't fit in a small string");
+		REQUIRE(t.Get<int64_t>("Row 19999", "Integer Field") == 19999);
+		REQUIRE(t.Get<ArenaString>(7, 0).get_allocator().GetArena() != nullptr);
+
+		// Allocators are equal only within one table's arena, including the arenas used by each thread
+		REQUIRE(t.Get<ArenaString>(7, 0).get_allocator() == t.Get<ArenaString>(19999, 0).get_allocator());
+		REQUIRE(t.Get<ArenaString>(7, 0).get_allocator() != s.Get<ArenaString>(7, 0).get_allocator());
+		REQUIRE(t.Get<ArenaString>(7, 0).get_allocator() != ArenaAllocator<char>(nullptr));
+
+		// Copies allocate from the heap, and assignment keeps each table's memory alive
+		ArenaTable copy = t;
+		REQUIRE(copy.Get<ArenaString>(7, 0).get_allocator().GetArena() == nullptr);
+		copy = s;
+		s = ArenaTable("Name,Value\nA,1\n");
+		REQUIRE(copy.Get<ArenaString>("Row 19999", "Text Field") == "Some longer text that won't fit in a small string");
+		REQUIRE(s.Get<int64_t>("A", "Value") == 1);
+
+		auto snapshot = ArenaTable::FromSnapshot(t.ToSnapshot());
+		REQUIRE(snapshot);
+		REQUIRE(snapshot.Get<ArenaString>("Row 3", "Text Field") == "Quoted, multi-line\n\"text\"");
+
+		// Arenas are also usable as memory resources
+		Arena arena;
+		void * data = arena.Allocate(100, 64);
+		REQUIRE(reinterpret_cast<uintptr_t>(data) % 64 == 0);
+		REQUIRE(arena.GetSize() >= 100);
+#ifdef TBL_PMR
+		std::pmr::vector<int> values(&arena);
+		values.resize(1000, 1);
+		REQUIRE(values.back() == 1);
+		Table<std::pmr::polymorphic_allocator<char>> p(tableText);
+		REQUIRE(p);
+		REQUIRE(p.Get<int64_t>("Row 19999", "Integer Field") == 19999);
+#endif
+	}
+
+	SECTION("Comma-Delimited Table Test Using Dictionary Encoding")
+	{
+		static const char * rarities[] = { "Common", "Uncommon", "Rare", "\"Epic, \"\"Legendary\"\"\"" };
+		std::string tableText = "Name Field,Rarity,Text Field\n";
+		for (int i = 0; i < 1000; ++i)
+			tableText += "Row " + std::to_string(i) + "," + rarities[i % 4] + ",Text " + std::to_string(i) + "\n";
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetColumnType(1) == ColumnType::String);
+		REQUIRE(t.GetCodes("Rarity").size() == 1000);
+		REQUIRE(t.GetDictionary("Rarity").size() == 4);
+		REQUIRE(t.GetColumn<String>("Rarity").empty());
+		REQUIRE(t.GetCodes("Text Field").empty());
+		REQUIRE(t.GetColumn<String>("Text Field").size() == 1000);
+		REQUIRE(t.Get<String>("Row 3", "Rarity") == "Epic, \"Legendary\"");
+		REQUIRE(&t.Get<String>("Row 1", "Rarity") == &t.Get<String>("Row 5", "Rarity"));
+		REQUIRE(std::get<String>(t.GetData("Row 2", "Rarity")) == "Rare");
+
+		const uint32_t rare = t.FindCode("Rarity", "Rare");
+		REQUIRE(rare != Table<>::NoCode);
+		REQUIRE(t.GetDictionary("Rarity")[rare] == "Rare");
+		REQUIRE(std::count(t.GetCodes("Rarity").begin(), t.GetCodes("Rarity").end(), rare) == 250);
+		REQUIRE(t.FindCode("Rarity", "Mythic") == Table<>::NoCode);
+		REQUIRE(t.FindCode("Text Field", "Text 1") == Table<>::NoCode);
+
+		auto snapshot = Table<>::FromSnapshot(t.ToSnapshot());
+		REQUIRE(snapshot.GetCodes("Rarity").size() == 1000);
+		REQUIRE(snapshot.Get<String>("Row 999", "Rarity") == "Epic, \"Legendary\"");
+
+		TableView<> v(tableText);
+		REQUIRE(v.Get<std::string_view>("Row 998", "Rarity") == "Rare");
+		REQUIRE(v.GetDictionary("Rarity").size() == 4);
+
+		Options options;
+		options.dictionaryRatio = 0.0;
+		Table u(tableText, options);
+		REQUIRE(u.GetCodes("Rarity").empty());
+		REQUIRE(u.GetColumn<String>("Rarity").size() == 1000);
+
+		// Snapshots keep each column's encoding, along with its dictionary
+		REQUIRE(snapshot.FindCode("Rarity", "Rare") == rare);
+		auto unencoded = Table<>::FromSnapshot(u.ToSnapshot());
+		REQUIRE(unencoded.GetCodes("Rarity").empty());
+		REQUIRE(unencoded.Get<String>("Row 2", "Rarity") == "Rare");
+	}
+
+	SECTION("Comma-Delimited Table Test Using Compact Mixed Cells")
+	{
+		std::string tableText = "Name Field,Mixed Field\n";
+		for (int i = 0; i < 20000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + ",";
+			if (i % 3 == 0)
+				tableText += std::to_string(i) + "\n";
+			else if (i % 3 == 1)
+				tableText += std::to_string(i) + ".5\n";
+			else
+				tableText += "\"Text, " + std::to_string(i) + "\"\n";
+		}
+
+		Options options;
+		options.threads = 4;
+		Table t(tableText, options);
+		REQUIRE(t);
+		REQUIRE(t.GetColumnType(1) == ColumnType::Mixed);
+		bool matches = true;
+		for (int i = 0; i < 20000; ++i)
+		{
+			const std::string row = "Row " + std::to_string(i);
+			if (i % 3 == 0)
+				matches = matches && t.Get<int64_t>(row, "Mixed Field") == i;
+			else if (i % 3 == 1)
+				matches = matches && t.Get<double>(row, "Mixed Field") == i + 0.5;
+			else
+				matches = matches && t.Get<String>(row, "Mixed Field") == "Text, " + std::to_string(i);
+		}
+		REQUIRE(matches);
+		REQUIRE(std::get<String>(t.GetData("Row 19997", "Mixed Field")) == "Text, 19997");
+		REQUIRE(std::get<double>(t.GetData("Row 19996", "Mixed Field")) == 19996.5);
+
+		const auto data = t.ToSnapshot();
+		auto snapshot = TableView<>::FromSnapshot(data);
+		REQUIRE(snapshot.GetColumnType(1) == ColumnType::Mixed);
+		REQUIRE(snapshot.Get<std::string_view>("Row 19997", "Mixed Field") == "Text, 19997");
+		REQUIRE(snapshot.Get<int64_t>("Row 19998", "Mixed Field") == 19998);
+	}
+
+	SECTION("Comma-Delimited Table Test Estimating Rows")
+	{
+		std::string tableText = "Name Field,Integer Field,Text Field\r\n";
+		for (int i = 0; i < 1000; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(i) + ",";
+			tableText += (i % 3 == 0) ? "\"Quoted, multi-line\r\n\"\"text\"\"\"\r\n" : "Plain text\r\n";
+		}
+
+		// The header row and every data row end in a line feed outside of quotes
+		Detail::Scanner scanner(tableText, ',');
+		REQUIRE(scanner.EstimateRows(0, tableText.size()) == 1002);
+		const size_t header = tableText.find('\n') + 1;
+		REQUIRE(scanner.EstimateRows(header, tableText.size()) == 1001);
+		REQUIRE(scanner.EstimateRows(header, tableText.find("Row 3,")) == 4);
+
+		std::string macText = tableText;
+		macText.erase(std::remove(macText.begin(), macText.end(), '\n'), macText.end());
+		Detail::Scanner macScanner(macText, ',');
+		REQUIRE(macScanner.EstimateRows(0, macText.size()) == 1002);
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetNumRows() == 1000);
+		REQUIRE(t.Get<String>("Row 999", "Text Field") == "Quoted, multi-line\r\n\"text\"");
+	}
+
+	SECTION("Table Set Test From Files")
+	{
+		const auto test1 = GetTestDataPath("Test1.csv");
+		const auto test2 = GetTestDataPath("Test2.txt");
+		const auto test3 = GetTestDataPath("Test3.csv");
+		const auto missing = GetTestDataPath("Missing.csv");
+		const auto image = GetTestDataPath("Img1.png");
+		TableSet<> tables({ { "Test 1", test1 }, { "Test 2", test2 }, { "Test 3", test3 }, { "Missing", missing }, { "Image", image } }, 2);
+		REQUIRE(!tables);
+		REQUIRE(tables.GetNumTables() == 5);
+		REQUIRE(tables.GetTableIndex("Test 3") == 2);
+		REQUIRE(tables.GetName(1) == "Test 2");
+		REQUIRE(tables.GetError("Test 1") == LoadError::None);
+		REQUIRE(tables.GetError("Test 2") == LoadError::None);
+		REQUIRE(tables.GetError("Test 3") == LoadError::None);
+		REQUIRE(tables.GetError("Missing") == LoadError::File);
+		REQUIRE(tables.GetError("Image") == LoadError::Parse);
+		REQUIRE(tables.FindTable("Missing") == nullptr);
+		REQUIRE(tables.FindTable("Unknown") == nullptr);
+		REQUIRE(tables.FindTable("Test 2") == &tables.GetTable("Test 2"));
+
+		const auto & t = tables.GetTable("Test 2");
+		REQUIRE(t.GetNumColumns() == 2);
+		REQUIRE(t.GetNumRows() == 3);
+		REQUIRE(t.Get<String>("Test Name B", "Text Field") == "\"Quoted text\"");
+		REQUIRE(tables.GetTable("Test 1"));
+		REQUIRE(tables.GetTable("Test 3"));
+
+		TableSet<std::allocator<char>, std::string_view> views({ { "Test 2", test2 } });
+		REQUIRE(views);
+		REQUIRE(views.GetTable("Test 2").Get<std::string_view>("Test Name C", "Text Field") == "Try \"A, B, C\" for fun!");
+
+		// A repeated name is an error, and doesn't shift the tables named after it
+		TableSet<> repeated({ { "Test 2", test2 }, { "Test 2", test1 }, { "Test 3", test3 }, { "Missing", missing } }, 2);
+		REQUIRE(!repeated);
+		REQUIRE(repeated.GetTableIndex("Test 2") == 0);
+		REQUIRE(repeated.GetTableIndex("Test 3") == 2);
+		REQUIRE(repeated.GetTableIndex("Missing") == 3);
+		REQUIRE(repeated.GetError("Missing") == LoadError::File);
+		REQUIRE(repeated.FindTable("Test 3") == &repeated.GetTable(2));
+		REQUIRE(repeated.GetTable("Test 2").Get<String>("Test Name B", "Text Field") == "\"Quoted text\"");
+	}
+
+	SECTION("Comma-Delimited Table Test Using Column Aggregates")
+	{
+		std::string tableText = "Name Field,Integer Field,Double Field,Mixed Field,Text Field\n";
+		int64_t intSum = 0, intMin = INT64_MAX, intMax = INT64_MIN, mixedIntSum = 0;
+		double doubleSum = 0.0, mixedDoubleSum = 0.0;
+		size_t mixedCount = 0;
+		for (int i = 0; i < 1003; ++i)
+		{
+			const int64_t value = (i * 7919) % 2003 - 1000;
+			const double doubleValue = static_cast<double>(value) + 0.25;
+			intSum += value;
+			intMin = std::min(intMin, value);
+			intMax = std::max(intMax, value);
+			doubleSum += doubleValue;
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(value) + "," + std::to_string(doubleValue) + ",";
+			if (i % 3 == 0)
+			{
+				tableText += std::to_string(value);
+				mixedIntSum += value;
+				++mixedCount;
+			}
+			else if (i % 3 == 1)
+			{
+				tableText += std::to_string(doubleValue);
+				mixedDoubleSum += doubleValue;
+				++mixedCount;
+			}
+			else
+				tableText += "Text";
+			tableText += ",Text\n";
+		}
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(t.GetColumnType(t.GetColumnIndex("Mixed Field")) == ColumnType::Mixed);
+		REQUIRE(t.Count("Integer Field") == 1003);
+		REQUIRE(t.Sum("Integer Field") == static_cast<double>(intSum));
+		REQUIRE(t.Min("Integer Field") == static_cast<double>(intMin));
+		REQUIRE(t.Max("Integer Field") == static_cast<double>(intMax));
+		REQUIRE(t.Mean("Integer Field") == Approx(static_cast<double>(intSum) / 1003.0));
+		REQUIRE(t.Count("Double Field") == 1003);
+		REQUIRE(t.Sum("Double Field") == Approx(doubleSum));
+		REQUIRE(t.Min("Double Field") == static_cast<double>(intMin) + 0.25);
+		REQUIRE(t.Max("Double Field") == static_cast<double>(intMax) + 0.25);
+		REQUIRE(t.Count("Mixed Field") == mixedCount);
+		REQUIRE(t.Sum("Mixed Field") == Approx(static_cast<double>(mixedIntSum) + mixedDoubleSum));
+		REQUIRE(t.Mean("Mixed Field") == Approx((static_cast<double>(mixedIntSum) + mixedDoubleSum) / static_cast<double>(mixedCount)));
+		const auto & names = t.GetColumn<String>(0);
+		double mixedMin = 1e9, mixedMax = -1e9;
+		for (size_t row = 0; row < names.size(); ++row)
+		{
+			const auto data = t.GetData(row, t.GetColumnIndex("Mixed Field"));
+			if (data.index() == 2)
+				continue;
+			const double value = data.index() == 0 ? static_cast<double>(std::get<int64_t>(data)) : std::get<double>(data);
+			mixedMin = std::min(mixedMin, value);
+			mixedMax = std::max(mixedMax, value);
+		}
+		REQUIRE(t.Min("Mixed Field") == mixedMin);
+		REQUIRE(t.Max("Mixed Field") == mixedMax);
+		REQUIRE(t.Count("Text Field") == 0);
+		REQUIRE(t.Sum("Text Field") == 0.0);
+		REQUIRE(std::isnan(t.Min("Text Field")));
+		REQUIRE(std::isnan(t.Mean("Text Field")));
+
+		// Integer sums too large for 64 bits are still summed correctly
+		std::string bigText = "Name Field,Big Field,Negative Field,Mixed Field\n";
+		for (int i = 0; i < 1001; ++i)
+			bigText += "Row " + std::to_string(i) + ",9000000000000000000,-9000000000000000000," + (i % 2 ? "Text" : "9000000000000000000") + "\n";
+		Table big(bigText);
+		REQUIRE(big);
+		REQUIRE(big.GetColumnType(1) == ColumnType::Integer);
+		REQUIRE(big.Sum("Big Field") == Approx(9.009e21));
+		REQUIRE(big.Sum("Negative Field") == Approx(-9.009e21));
+		REQUIRE(big.Sum("Mixed Field") == Approx(4.509e21));
+		REQUIRE(big.Mean("Big Field") == Approx(9e18));
+	}
+
+	SECTION("Comma-Delimited Table Test Using Hash Indexes")
+	{
+		std::string tableText = "Name Field,Item Id,Category,Weight,Mixed Field\n";
+		for (int i = 0; i < 500; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(1000 + i) + ",Category " + std::to_string(i % 7) + ",";
+			tableText += std::to_string(i % 4) + ".5,";
+			tableText += (i % 2) ? std::to_string(i % 5) : "Text " + std::to_string(i % 5);
+			tableText += "\n";
+		}
+
+		Table t(tableText);
+		REQUIRE(t);
+		REQUIRE(!t.HasIndex("Item Id"));
+		t.BuildIndex("Item Id");
+		t.BuildIndex("Category");
+		t.BuildIndex("Weight");
+		t.BuildIndex("Mixed Field");
+		REQUIRE(t.HasIndex("Item Id"));
+
+		auto rows = t.FindRows("Item Id", 1234);
+		REQUIRE(rows.size() == 1);
+		REQUIRE(rows[0] == t.GetRowIndex("Row 234"));
+		REQUIRE(t.FindRows("Item Id", 999).empty());
+		REQUIRE(t.FindRows("Item Id", 1234.0).empty());
+
+		rows = t.FindRows("Category", "Category 3");
+		REQUIRE(rows.size() == 71);
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			REQUIRE(rows[i] == 3 + i * 7);
+			REQUIRE(t.Get<String>(rows[i], 2) == "Category 3");
+		}
+		REQUIRE(t.FindRows("Category", std::string("Category 9")).empty());
+
+		REQUIRE(t.FindRows("Weight", 2.5).size() == 125);
+		REQUIRE(t.FindRows("Weight", -0.0).empty());
+
+		REQUIRE(t.FindRows("Mixed Field", 3).size() == 50);
+		REQUIRE(t.FindRows("Mixed Field", "Text 4").size() == 50);
+		REQUIRE(t.FindRows("Mixed Field", "3").empty());
+
+		const Table copy = t;
+		REQUIRE(copy.HasIndex("Category"));
+		REQUIRE(copy.FindRows("Category", Name("Category 6")).size() == 71);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Range Indexes")
+	{
+		std::string tableText = "Name Field,Level,Price,Mixed Field\n";
+		const int rowCount = 70000;
+		for (int i = 0; i < rowCount; ++i)
+		{
+			const int level = (i * 37) % 100;
+			tableText += "Row " + std::to_string(i) + "," + std::to_string(level) + "," + std::to_string(level) + ".5,";
+			tableText += (i % 3 == 0) ? "Text" : (i % 3 == 1) ? std::to_string(level) : std::to_string(level) + ".25";
+			tableText += "\n";
+		}
+
+		Table t(tableText);
+		REQUIRE(t);
+		t.BuildRangeIndex("Level", 4);
+		t.BuildRangeIndex("Price");
+		t.BuildRangeIndex("Mixed Field", 3);
+		REQUIRE(t.HasRangeIndex("Level"));
+		REQUIRE(!t.HasRangeIndex(0));
+
+		auto checkRange = [&](const char * column, double lo, double hi)
+		{
+			const size_t columnIndex = t.GetColumnIndex(column);
+			std::vector<std::pair<double, uint32_t>> expected;
+			for (uint32_t row = 0; row < t.GetNumRows(); ++row)
+			{
+				const auto data = t.GetData(row, columnIndex);
+				if (data.index() == 2)
+					continue;
+				const double value = data.index() == 0 ? static_cast<double>(std::get<int64_t>(data)) : std::get<double>(data);
+				if (value >= lo && value <= hi)
+					expected.emplace_back(value, row);
+			}
+			std::stable_sort(expected.begin(), expected.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+			const auto rows = t.Range(column, lo, hi);
+			bool matches = rows.size() == expected.size();
+			for (size_t i = 0; matches && i < rows.size(); ++i)
+				matches = rows[i] == expected[i].second;
+			return matches;
+		};
+		REQUIRE(checkRange("Level", 20, 30));
+		REQUIRE(checkRange("Level", -10, 200));
+		REQUIRE(checkRange("Price", 20, 30));
+		REQUIRE(checkRange("Mixed Field", 49.25, 60));
+		REQUIRE(t.Range("Level", 20, 30).size() == 7700);
+		REQUIRE(t.Range("Level", 30, 20).empty());
+		REQUIRE(t.Range("Price", 20, 20.25).empty());
+		REQUIRE(t.Range("Mixed Field", 0, 100).size() == 46666);
+
+		// Groups with no numeric cells have a NaN mean, which is never in a range
+		std::string groupText = "Group,Value\n";
+		for (int i = 0; i < 40000; ++i)
+			groupText += std::to_string(i % 1000) + "," + ((i % 1000) % 3 ? std::to_string(i % 97) : "Text") + "\n";
+		auto means = Table(groupText).GroupBy("Group").Aggregate({ Mean("Value") });
+		REQUIRE(means);
+		means.BuildRangeIndex("Mean(Value)", 4);
+		REQUIRE(means.Range("Mean(Value)", -1e300, 1e300).size() == 666);
+		REQUIRE(means.Range("Mean(Value)", 0, std::numeric_limits<double>::infinity()).size() == 666);
+		REQUIRE(means.Range("Mean(Value)", std::numeric_limits<double>::quiet_NaN(), 100).empty());
+		bool ordered = true;
+		const auto meanRows = means.Range("Mean(Value)", -1e300, 1e300);
+		for (size_t i = 1; i < meanRows.size(); ++i)
+			ordered = ordered && means.Get<double>(meanRows[i - 1], 1) <= means.Get<double>(meanRows[i], 1);
+		REQUIRE(ordered);
+	}
+
+	SECTION("Comma-Delimited Table Test Using Hash Joins")
+	{
+		std::string itemsText = "Name,Stat Id,Value\n";
+		for (int i = 0; i < 200; ++i)
+			itemsText += "Item " + std::to_string(i) + "," + std::to_string(i % 10) + "," + std::to_string(i * 2) + "\n";
+		std::string statsText = "Stat Name,Stat Id,Damage,Description\n";
+		for (int i = 0; i < 12; i += 2)
+			statsText += "Stat " + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i * 100) + ",\"Quoted, \"\"stat\"\"\"\n";
+
+		Table items(itemsText);
+		Table stats(statsText);
+		REQUIRE(items);
+		REQUIRE(stats);
+
+		// Each item with an even stat id joins to one stat
+		auto joined = Join(items, "Stat Id", stats, "Stat Id");
+		REQUIRE(joined.size() == 100);
+		for (size_t i = 0; i < joined.size(); ++i)
+		{
+			const auto & row = joined[i];
+			REQUIRE(row.left == i * 2);
+			REQUIRE(items.Get<int64_t>(row.left, 1) == stats.Get<int64_t>(row.right, 1));
+		}
+
+		auto t = joined.ToTable();
+		REQUIRE(t);
+		REQUIRE(t.GetNumRows() == 100);
+		REQUIRE(t.GetNumColumns() == 6);
+		REQUIRE(t.Get<int64_t>("Item 14", "Damage") == 400);
+		REQUIRE(t.Get<int64_t>("Item 14", "Value") == 28);
+		REQUIRE(t.Get<String>("Item 14", "Stat Name") == "Stat 4");
+		REQUIRE(t.Get<String>("Item 14", "Description") == "Quoted, \"stat\"");
+
+		// Joining the other way pairs each stat with several items, ordered by stat row
+		stats.BuildIndex("Stat Id");
+		auto reversed = Join(stats, "Stat Id", items, "Stat Id");
+		REQUIRE(reversed.size() == 100);
+		REQUIRE(reversed[0].left == 0);
+		REQUIRE(reversed[0].right == 0);
+		REQUIRE(reversed[1].right == 10);
+		REQUIRE(reversed[99].left == 4);
+		REQUIRE(reversed[99].right == 198);
+		auto reversedTable = reversed.ToTable();
+		REQUIRE(reversedTable);
+		REQUIRE(reversedTable.GetNumRows() == 100);
+		REQUIRE(reversedTable.Get<int64_t>("Stat 2", "Value") == 4);
+		REQUIRE(reversedTable.Get<int64_t>(size_t(99), reversedTable.GetColumnIndex("Value")) == 396);
+
+		// Right columns that share a left column's name are kept with a prefix
+		std::string namedText = "Name,Stat Id,Value\n";
+		for (int i = 0; i < 10; ++i)
+			namedText += "Stat " + std::to_string(i) + "," + std::to_string(i) + "," + std::to_string(i * 3) + "\n";
+		Table named(namedText);
+		REQUIRE(named);
+		auto namedTable = Join(items, "Stat Id", named, "Stat Id").ToTable();
+		REQUIRE(namedTable);
+		REQUIRE(namedTable.GetNumRows() == 200);
+		REQUIRE(namedTable.GetNumColumns() == 5);
+		REQUIRE(namedTable.GetColumnIndex("Right Name") == 3);
+		REQUIRE(namedTable.Get<int64_t>("Item 17", "Value") == 34);
+		REQUIRE(namedTable.Get<int64_t>("Item 17", "Right Value") == 21);
+		REQUIRE(namedTable.Get<String>("Item 17", "Right Name") == "Stat 7");
+		auto prefixedTable = Join(items, "Stat Id", named, "Stat Id").ToTable(Options(), "Stat ");
+		REQUIRE(prefixedTable.Get<String>("Item 17", "Stat Name") == "Stat 7");
+		REQUIRE(!Join(items, "Stat Id", named, "Stat Id").ToTable(Options(), ""));
+
+		auto none = Join(items, "Value", stats, "Stat Name");
+		REQUIRE(none.empty());
+
+		TableView<> itemView(itemsText);
+		TableView<> statView(statsText);
+		auto viewTable = Join(itemView, "Stat Id", statView, "Stat Id").ToTable();
+		REQUIRE(viewTable);
+		REQUIRE(viewTable.Get<std::string_view>("Item 16", "Description") == "Quoted, \"stat\"");
+	}
+
+	SECTION("Comma-Delimited Table Test Using Group By")
+	{
+		std::string tableText = "Name Field,Category,Level,Gold,Weight,Mixed Field\n";
+		const int rowCount = 50000;
+		for (int i = 0; i < rowCount; ++i)
+		{
+			tableText += "Row " + std::to_string(i) + ",Category " + std::to_string(i % 7) + "," + std::to_string(i % 5) + ",";
+			tableText += std::to_string(i) + "," + std::to_string(i % 4) + ".5,";
+			tableText += (i % 2) ? std::to_string(i % 3) : "Text";
+			tableText += "\n";
+		}
+
+		Table t(tableText);
+		REQUIRE(t);
+		for (size_t threads : { size_t(1), size_t(4) })
+		{
+			auto g = t.GroupBy("Category", threads).Aggregate({ Sum("Gold"), Count(), Min("Gold"), Max("Weight"), Mean("Gold", "Average Gold"), Count("Mixed Field"), Sum("Mixed Field") });
+			REQUIRE(g);
+			REQUIRE(g.GetNumRows() == 7);
+			REQUIRE(g.GetNumColumns() == 8);
+			REQUIRE(g.Get<String>(0, 0) == "Category 0");
+			REQUIRE(g.Get<String>(6, 0) == "Category 6");
+			for (int category = 0; category < 7; ++category)
+			{
+				int64_t sum = 0, count = 0, mixedCount = 0, mixedSum = 0;
+				for (int i = category; i < rowCount; i += 7)
+				{
+					sum += i;
+					++count;
+					if (i % 2)
+					{
+						++mixedCount;
+						mixedSum += i % 3;
+					}
+				}
+				const std::string row = "Category " + std::to_string(category);
+				REQUIRE(g.Get<int64_t>(row, "Sum(Gold)") == sum);
+				REQUIRE(g.Get<int64_t>(row, "Count") == count);
+				REQUIRE(g.Get<int64_t>(row, "Min(Gold)") == category);
+				REQUIRE(g.Get<double>(row, "Max(Weight)") == 3.5);
+				REQUIRE(g.Get<double>(row, "Average Gold") == Approx(static_cast<double>(sum) / static_cast<double>(count)));
+				REQUIRE(g.Get<int64_t>(row, "Count(Mixed Field)") == mixedCount);
+				REQUIRE(g.Get<double>(row, "Sum(Mixed Field)") == static_cast<double>(mixedSum));
+			}
+		}
+
+		auto levels = t.GroupBy("Level", 3).Aggregate({ Count(), Sum("Weight") });
+		REQUIRE(levels);
+		REQUIRE(levels.GetNumRows() == 5);
+		REQUIRE(levels.Get<int64_t>("4", "Count") == 10000);
+		REQUIRE(levels.Get<String>(2, 0) == "2");
+
+		auto weights = t.GroupBy("Weight").Aggregate({ Count() });
+		REQUIRE(weights.Get<int64_t>("2.5", "Count") == 12500);
+
+		REQUIRE(!t.GroupBy("Category").Aggregate({ Sum("Unknown") }));
+
+		TableView<> v(tableText);
+		auto viewGroups = v.GroupBy("Category").Aggregate({ Sum("Gold") });
+		REQUIRE(viewGroups);
+		REQUIRE(viewGroups.Get<std::string_view>(3, 0) == "Category 3");
+		REQUIRE(viewGroups.Get<int64_t>("Category 3", "Sum(Gold)") == t.GroupBy("Category").Aggregate({ Sum("Gold") }).Get<int64_t>("Category 3", "Sum(Gold)"));
+	}
+
 }
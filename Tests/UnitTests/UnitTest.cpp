@@ -13,7 +13,7 @@ Copyright (c) 2019 James Boer
 using namespace Tbl;
 
 
-std::string LoadTestData(const char* filename)
+std::string GetTestDataPath(const char* filename)
 {
 #ifdef TBL_WINDOWS
 	std::string filePath = std::string("../../../Data/") + std::string(filename);
@@ -21,11 +21,15 @@ std::string LoadTestData(const char* filename)
 	std::string filePath = std::string("../../../../Data/") + std::string(filename);
 #endif
 
-	std::ifstream f(filePath);
-	if (!f)
-		f.open(std::string("../Data/") + std::string(filename));
+	if (!std::ifstream(filePath))
+		filePath = std::string("../Data/") + std::string(filename);
+	return filePath;
+}
+
+std::string LoadTestData(const char* filename)
+{
+	std::ifstream f(GetTestDataPath(filename));
 	std::stringstream buffer;
 	buffer << f.rdbuf();
 	return buffer.str();
 }
-
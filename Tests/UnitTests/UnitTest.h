@@ -11,5 +11,6 @@ Copyright (c) 2019 James Boer
 
 #include "catch.hpp"
 
+std::string GetTestDataPath(const char* filename);
 std::string LoadTestData(const char* filename);
 